@@ -4,19 +4,74 @@
 #include "AutoMesh.h"
 
 #include "AssetToolsModule.h"
+#include "AutoMeshDependencyIndex.h"
+#include "AutoMeshProfiler.h"
 #include "ContentBrowserModule.h"
 #include "HairStrandsInterface.h"
 #include "IContentBrowserSingleton.h"
+#include "ImageCore.h"
+#include "IImageWrapperModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
 #include "Engine/StaticMeshActor.h"
+#include "Engine/Texture2D.h"
+#include "EditorFramework/AssetImportData.h"
 #include "Factories/MaterialFactoryNew.h"
 #include "Factories/MaterialInstanceConstantFactoryNew.h"
 #include "Materials/MaterialExpressionTextureSampleParameter2D.h"
 #include "Materials/MaterialInstance.h"
 #include "Materials/MaterialInstanceConstant.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/SecureHash.h"
+#include "UObject/StrongObjectPtr.h"
 
 DEFINE_LOG_CATEGORY(LogAutoMesh);
 
+namespace AutoMeshTexture
+{
+	// Channel range below which a texture is considered a single color (~1/255)
+	constexpr float ConstantColorTolerance = 0.004f;
+	// Size constant color textures are clamped to by auto-fix (smallest block compressed size)
+	constexpr int32 ConstantTextureSize = 4;
+	// Pixels reduced per ParallelFor task
+	constexpr int64 PixelsPerChunk = 64 * 1024;
+	// Sources above this are analysed one at a time, an RGBA32F copy of 2048x2048 is 64 MiB
+	constexpr int64 MaxParallelSourcePixels = 2048 * 2048;
+	// Most images read per batch before textures are created
+	constexpr int32 ImportBatchSize = 64;
+	// Decoded bytes held per batch, a larger image is imported in a batch of its own
+	constexpr int64 ImportBatchBytes = 1024ll * 1024 * 1024;
+}
+
+namespace AutoMeshFactory
+{
+	TMap<UClass*, TStrongObjectPtr<UFactory>> Pool;
+
+	// Reuse one factory per class for the session instead of a NewObject per call
+	template <typename FactoryType>
+	FactoryType* Get()
+	{
+		TStrongObjectPtr<UFactory>& Factory = Pool.FindOrAdd(FactoryType::StaticClass());
+		if (!Factory.IsValid())
+		{
+			Factory.Reset(NewObject<FactoryType>());
+		}
+		return CastChecked<FactoryType>(Factory.Get());
+	}
+}
+
+namespace AutoMeshJournal
+{
+	FString GetJournalPath(const FString& JournalFilename)
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutoMesh"), JournalFilename);
+	}
+
+	// First line of journal, identifies the input set the records belong to
+	const FString RunKeyPrefix = TEXT("#");
+}
+
 class UMaterialFactoryNew;
 // Sets default values
 AAutoMesh::AAutoMesh()
@@ -54,6 +109,11 @@ TMap<FString, FString> AAutoMesh::GetAssetMap(UObject* Asset)
 	AssetMap.Add(TEXT("ObjectName"), AssetObjectName);
 	AssetMap.Add(TEXT("PackagePath"), AssetPackagePath);
 	AssetMap.Add(TEXT("PackageName"), AssetPackageName);
+	FAutoMeshProfiler::CountAllocations(AssetObjectPath, AssetObjectName, AssetPackagePath, AssetPackageName, AssetMap);
+	for (const TPair<FString, FString>& Entry : AssetMap)
+	{
+		FAutoMeshProfiler::CountAllocations(Entry.Key, Entry.Value);
+	}
 	return AssetMap;
 }
 
@@ -91,6 +151,7 @@ UMaterial* AAutoMesh::CreateMasterMaterial(UStaticMesh* StaticMesh)
 	// e.g.: /Game/Meshes/Structure/SM_Structure_MeshName -> /Game/Materials/M_Structure
 	
 	checkf(StaticMesh != nullptr, TEXT("nullptr: StaticMesh"));
+	AUTOMESH_PROFILE_SCOPE(MasterMaterial, StaticMesh->GetOutermost()->GetFName());
 
 	TMap<FString, FString> StaticMeshMap = AAutoMesh::GetAssetMap(StaticMesh);
 	const FString StaticMeshObjectPath = StaticMeshMap["ObjectPath"];
@@ -136,6 +197,9 @@ UMaterial* AAutoMesh::CreateMasterMaterial(UStaticMesh* StaticMesh)
 	{
 		UE_LOG(LogAutoMesh, Error, TEXT("Invalid PackageName: %s"), *MaterialPackageName);
 	}
+	FAutoMeshProfiler::CountAllocations(StaticMeshObjectPath, StaticMeshObjectName, StaticMeshPackagePath,
+		StaticMeshPackageName, PackagePathArray, MaterialPackagePath, ObjectNameArray, MaterialObjectName,
+		MaterialPackageName);
 	
 	UE_LOG(LogAutoMesh, Warning, TEXT("MaterialPackageName: %s"), *MaterialPackageName);
 
@@ -160,7 +224,7 @@ UMaterial* AAutoMesh::CreateMasterMaterial(UStaticMesh* StaticMesh)
 	}
 	else
 	{
-		UMaterialFactoryNew* Factory = NewObject<UMaterialFactoryNew>();
+		UMaterialFactoryNew* Factory = AutoMeshFactory::Get<UMaterialFactoryNew>();
 		NewMaterial = Cast<UMaterial>(
 			AAutoMesh::CreateAsset(
 				Factory,
@@ -275,6 +339,7 @@ UMaterialInstanceConstant* AAutoMesh::CreateMaterialInstance(UMaterial* MasterMa
 {
 	checkf(MasterMaterial != nullptr, TEXT("nullptr: MasterMaterial"));
 	checkf(StaticMesh != nullptr, TEXT("nullptr: StaticMesh"));
+	AUTOMESH_PROFILE_SCOPE(MaterialInstance, StaticMesh->GetOutermost()->GetFName());
 	
 	TMap<FString, FString> StaticMeshMap = AAutoMesh::GetAssetMap(StaticMesh);
 	const FString StaticMeshObjectPath = StaticMeshMap["ObjectPath"];
@@ -296,10 +361,13 @@ UMaterialInstanceConstant* AAutoMesh::CreateMaterialInstance(UMaterial* MasterMa
 		TEXT("SM_"),
 		TEXT("MI_")
 	);
+	FAutoMeshProfiler::CountAllocations(StaticMeshObjectPath, StaticMeshObjectName, StaticMeshPackagePath,
+		StaticMeshPackageName, MaterialInstancePackagePath, MaterialInstanceObjectName,
+		MaterialInstancePackageName);
 
 	UE_LOG(LogAutoMesh, Warning, TEXT("MaterialInstancePackageName: %s"), *MaterialInstancePackageName);
 
-	UMaterialInstanceConstantFactoryNew* Factory = NewObject<UMaterialInstanceConstantFactoryNew>();
+	UMaterialInstanceConstantFactoryNew* Factory = AutoMeshFactory::Get<UMaterialInstanceConstantFactoryNew>();
 	Factory->InitialParent = MasterMaterial;
 	UMaterialInstanceConstant* NewMaterialInstance = Cast<UMaterialInstanceConstant>(
 		AAutoMesh::CreateAsset(
@@ -310,6 +378,13 @@ UMaterialInstanceConstant* AAutoMesh::CreateMaterialInstance(UMaterial* MasterMa
 			MaterialInstancePackagePath
 		)
 	);
+	// Pooled factory must not keep the master material alive
+	Factory->InitialParent = nullptr;
+	checkf(NewMaterialInstance != nullptr, TEXT("nullptr: NewMaterialInstance"));
+	if (NewMaterialInstance->Parent != MasterMaterial)
+	{
+		NewMaterialInstance->SetParentEditorOnly(MasterMaterial);
+	}
 	NewMaterialInstance = AAutoMesh::AddTexturesToMIC(NewMaterialInstance, StaticMesh);
 	checkf(NewMaterialInstance != nullptr, TEXT("nullptr: NewMaterialInstance"));
 	return NewMaterialInstance;
@@ -332,8 +407,24 @@ UObject* AAutoMesh::CreateAsset(UFactory* Factory, UClass* StaticClass, const FS
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::
 		LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
 	
+	// Reuse existing asset so reruns of the pipeline are idempotent
+	if (FPackageName::DoesPackageExist(*PackageName))
+	{
+		UE_LOG(LogAutoMesh, Warning, TEXT("Existing Package: %s"), *PackageName);
+		UObject* ExistingAsset = StaticLoadObject(
+			StaticClass,
+			nullptr,
+			*(PackageName + TEXT(".") + ObjectName)
+		);
+		if (ExistingAsset == nullptr)
+		{
+			UE_LOG(LogAutoMesh, Error, TEXT("Invalid Existing Asset Class: %s"), *PackageName);
+		}
+		return ExistingAsset;
+	}
+	
 	UE_LOG(LogAutoMesh, Warning, TEXT("Creating Asset: %s"), *PackageName);
-	UPackage* Package = CreatePackage(*PackageName);
+	CreatePackage(*PackageName);
 	UObject* NewAsset = AssetToolsModule.Get().CreateAsset(
 		*ObjectName,
 		*PackagePath,
@@ -342,16 +433,7 @@ UObject* AAutoMesh::CreateAsset(UFactory* Factory, UClass* StaticClass, const FS
 	);
 	checkf(NewAsset != nullptr, TEXT("nullptr: NewAsset"));
 	
-	UE_LOG(LogAutoMesh, Warning, TEXT("Saving Package: %s"), *PackageName);
-	UPackage::Save(
-		Package,
-		NewAsset,
-		RF_Public | RF_Standalone,
-		*FPackageName::LongPackageNameToFilename(
-			*PackageName,
-			*FPackageName::GetAssetPackageExtension()
-		)
-	);
+	AAutoMesh::SaveAsset(NewAsset);
 	AssetRegistryModule.AssetCreated(NewAsset);
 	TArray<UObject*> Objects;
 	Objects.Add(NewAsset);
@@ -364,13 +446,8 @@ UMaterialInstanceConstant* AAutoMesh::AddTexturesToMIC(UMaterialInstanceConstant
 {
 	checkf(MaterialInstance != nullptr, TEXT("nullptr: MaterialInstance"));
 	checkf(StaticMesh != nullptr, TEXT("nullptr: StaticMesh"));
+	AUTOMESH_PROFILE_SCOPE(Textures, StaticMesh->GetOutermost()->GetFName());
 	
-	TMap<FString, FString> StaticMeshMap = AAutoMesh::GetAssetMap(StaticMesh);
-	const FString StaticMeshObjectPath = StaticMeshMap["ObjectPath"];
-	const FString StaticMeshObjectName = StaticMeshMap["ObjectName"];
-	const FString StaticMeshPackagePath = StaticMeshMap["PackagePath"];
-	const FString StaticMeshPackageName = StaticMeshMap["PackageName"];
-
 	// Define standard UE texture parameters
 	TArray<FName> DiffuseMaskNormal =
 	{
@@ -383,32 +460,7 @@ UMaterialInstanceConstant* AAutoMesh::AddTexturesToMIC(UMaterialInstanceConstant
 	{
 		FString ParamStr;
 		Param.ToString(ParamStr);
-		
-		FString TexturePackagePath = StaticMeshPackagePath.Replace(
-			TEXT("Meshes"),
-			TEXT("Textures")
-		);
-
-		FString TextureObjectName = StaticMeshObjectName.Replace(
-			TEXT("SM_"),
-			TEXT("T_")
-		).Append(
-			"_"
-		).Append(
-			*ParamStr.Left(1)  // Use first letter of param for texture suffix
-		);
-
-		FString TexturePackageName = StaticMeshPackageName.Replace(
-			TEXT("SM_"),
-			TEXT("T_")
-		).Replace(
-			TEXT("Meshes"),
-			TEXT("Textures")
-		).Append(
-			"_"
-		).Append(
-			*ParamStr.Left(1)  // Use first letter of param for texture suffix
-		);
+		const FString TexturePackageName = AAutoMesh::GetTexturePackageName(StaticMesh, Param);
 		
 		if (FPackageName::DoesPackageExist(*TexturePackageName))
 		{
@@ -435,10 +487,847 @@ UStaticMesh* AAutoMesh::AssignMaterial(UMaterialInstanceConstant* MaterialInstan
 {
 	checkf(MaterialInstance != nullptr, TEXT("nullptr: MaterialInstance"));
 	checkf(StaticMesh != nullptr, TEXT("nullptr: StaticMesh"));
+	AUTOMESH_PROFILE_SCOPE(Assign, StaticMesh->GetOutermost()->GetFName());
 	
 	StaticMesh->SetMaterial(
 		0,
 		MaterialInstance
 	);
 	return StaticMesh;
-}
\ No newline at end of file
+}
+
+FString AAutoMesh::GetTexturePackageName(UStaticMesh* StaticMesh, const FName Param)
+{
+	checkf(StaticMesh != nullptr, TEXT("nullptr: StaticMesh"));
+	
+	TMap<FString, FString> StaticMeshMap = AAutoMesh::GetAssetMap(StaticMesh);
+	const FString StaticMeshPackageName = StaticMeshMap["PackageName"];
+	FString ParamStr;
+	Param.ToString(ParamStr);
+	
+	FString TexturePackageName = StaticMeshPackageName.Replace(
+		TEXT("SM_"),
+		TEXT("T_")
+	).Replace(
+		TEXT("Meshes"),
+		TEXT("Textures")
+	).Append(
+		"_"
+	).Append(
+		*ParamStr.Left(1)  // Use first letter of param for texture suffix
+	);
+	FAutoMeshProfiler::CountAllocations(StaticMeshPackageName, ParamStr, TexturePackageName);
+	return TexturePackageName;
+}
+
+TArray<FAutoMeshTextureReport> AAutoMesh::ValidateTextures(UStaticMesh* StaticMesh, const int32 MaxTextureSize,
+	const bool bAutoFix)
+{
+	checkf(StaticMesh != nullptr, TEXT("nullptr: StaticMesh"));
+	AUTOMESH_PROFILE_SCOPE(Validate, StaticMesh->GetOutermost()->GetFName());
+	
+	TArray<FName> DiffuseMaskNormal =
+	{
+		TEXT("Diffuse"),
+		TEXT("Mask"),
+		TEXT("Normal")
+	};
+
+	// Load textures on game thread, source mips are read on worker threads below
+	TArray<FAutoMeshTextureReport> Reports;
+	TArray<UTexture2D*> Textures;
+	for (FName Param : DiffuseMaskNormal)
+	{
+		const FString TexturePackageName = AAutoMesh::GetTexturePackageName(StaticMesh, Param);
+		if (!FPackageName::DoesPackageExist(*TexturePackageName))
+		{
+			UE_LOG(LogAutoMesh, Error, TEXT("Not Exists: %s"), *TexturePackageName);
+			continue;
+		}
+		UTexture2D* Texture = LoadObject<UTexture2D>(
+			nullptr,
+			*TexturePackageName
+		);
+		if (Texture == nullptr || !Texture->Source.IsValid())
+		{
+			UE_LOG(LogAutoMesh, Error, TEXT("Invalid Texture Source: %s"), *TexturePackageName);
+			continue;
+		}
+		FAutoMeshTextureReport& Report = Reports.AddDefaulted_GetRef();
+		Report.PackageName = TexturePackageName;
+		Report.Param = Param;
+		Textures.Add(Texture);
+	}
+
+	auto AnalyseTexture = [&Reports, &Textures, MaxTextureSize](const int32 Index)
+	{
+		AUTOMESH_PROFILE_WORKER_SCOPE(Validate);
+		UTexture2D* Texture = Textures[Index];
+		FAutoMeshTextureReport& Report = Reports[Index];
+		Report.SizeX = Texture->Source.GetSizeX();
+		Report.SizeY = Texture->Source.GetSizeY();
+		
+		FImage Image;
+		if (!Texture->Source.GetMipImage(Image, 0, 0, 0))
+		{
+			Report.bReadFailed = true;
+			return;
+		}
+		FAutoMeshProfiler::CountAllocations(Image.RawData);
+		// Convert in place, only one float copy of this source is alive
+		Image.ChangeFormat(ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+		FAutoMeshProfiler::CountAllocations(Image.RawData);
+		Report.Stats = AAutoMesh::ComputeTextureStats(Image.AsRGBA32F());
+
+		const FLinearColor Range = Report.Stats.Max - Report.Stats.Min;
+		Report.bConstantColor = FMath::Max(
+			FMath::Max(Range.R, Range.G),
+			FMath::Max(Range.B, Range.A)
+		) <= AutoMeshTexture::ConstantColorTolerance;
+		Report.bNonPowerOfTwo = !FMath::IsPowerOfTwo(Report.SizeX) || !FMath::IsPowerOfTwo(Report.SizeY);
+		Report.bOversized = FMath::Max(Report.SizeX, Report.SizeY) > MaxTextureSize;
+		
+		if (Report.Param == TEXT("Mask"))
+		{
+			const ETextureSourceFormat Format = Texture->Source.GetFormat();
+			Report.bBadMaskPacking = Texture->SRGB
+				|| Format == TSF_G8
+				|| Format == TSF_G16
+				|| Format == TSF_R16F
+				|| Format == TSF_R32F
+				|| (!Report.bConstantColor
+					&& Report.Stats.MaxChannelDelta <= AutoMeshTexture::ConstantColorTolerance);
+		}
+	};
+
+	// Small sources are analysed in parallel, each task only touches its own texture source
+	TArray<int32> SmallTextures;
+	TArray<int32> LargeTextures;
+	for (int32 Index = 0; Index < Textures.Num(); ++Index)
+	{
+		const int64 NumPixels = static_cast<int64>(Textures[Index]->Source.GetSizeX())
+			* Textures[Index]->Source.GetSizeY();
+		(NumPixels > AutoMeshTexture::MaxParallelSourcePixels ? LargeTextures : SmallTextures).Add(Index);
+	}
+	ParallelFor(SmallTextures.Num(), [&SmallTextures, &AnalyseTexture](const int32 Index)
+	{
+		AnalyseTexture(SmallTextures[Index]);
+	});
+	// Large sources one at a time, ComputeTextureStats still reduces each in parallel
+	for (const int32 Index : LargeTextures)
+	{
+		AnalyseTexture(Index);
+	}
+
+	for (int32 Index = 0; Index < Reports.Num(); ++Index)
+	{
+		FAutoMeshTextureReport& Report = Reports[Index];
+		if (Report.bReadFailed)
+		{
+			UE_LOG(LogAutoMesh, Error, TEXT("Read Failed: %s"), *Report.PackageName);
+			continue;
+		}
+		if (Report.bConstantColor)
+		{
+			UE_LOG(LogAutoMesh, Warning, TEXT("Constant Color: %s %s"), *Report.PackageName,
+				*Report.Stats.Mean.ToString());
+		}
+		if (Report.bNonPowerOfTwo)
+		{
+			UE_LOG(LogAutoMesh, Warning, TEXT("Non Power Of Two: %s %dx%d"), *Report.PackageName, Report.SizeX,
+				Report.SizeY);
+		}
+		if (Report.bOversized)
+		{
+			UE_LOG(LogAutoMesh, Warning, TEXT("Oversized: %s %dx%d"), *Report.PackageName, Report.SizeX,
+				Report.SizeY);
+		}
+		if (Report.bBadMaskPacking)
+		{
+			UE_LOG(LogAutoMesh, Warning, TEXT("Bad Mask Packing: %s"), *Report.PackageName);
+		}
+
+		if (!bAutoFix)
+		{
+			continue;
+		}
+		
+		// Fixes are non-destructive texture settings, the source pixels are left untouched
+		UTexture2D* Texture = Textures[Index];
+		if (Report.bConstantColor || Report.bOversized || (Report.bBadMaskPacking && Texture->SRGB))
+		{
+			Texture->Modify();
+		}
+		if (Report.bConstantColor)
+		{
+			Texture->MaxTextureSize = AutoMeshTexture::ConstantTextureSize;
+			Report.bFixed = true;
+		}
+		else if (Report.bOversized)
+		{
+			Texture->MaxTextureSize = MaxTextureSize;
+			Report.bFixed = true;
+		}
+		if (Report.bBadMaskPacking && Texture->SRGB)
+		{
+			Texture->SRGB = false;
+			Texture->CompressionSettings = TC_Masks;
+			Report.bFixed = true;
+		}
+		
+		if (Report.bFixed)
+		{
+			Texture->PostEditChange();
+			AAutoMesh::SaveAsset(Texture);
+		}
+	}
+	return Reports;
+}
+
+bool AAutoMesh::WriteTextureReport(const TArray<FAutoMeshTextureReport>& Reports, const FString ReportFilename)
+{
+	checkf(*ReportFilename != nullptr, TEXT("nullptr: ReportFilename"));
+	
+	FString ReportCSV = TEXT("PackageName,Param,SizeX,SizeY,Min,Max,Mean,ConstantColor,NonPowerOfTwo,Oversized,")
+		TEXT("BadMaskPacking,ReadFailed,Fixed\n");
+	for (const FAutoMeshTextureReport& Report : Reports)
+	{
+		ReportCSV += FString::Printf(
+			TEXT("%s,%s,%d,%d,\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%d,%d\n"),
+			*Report.PackageName,
+			*Report.Param.ToString(),
+			Report.SizeX,
+			Report.SizeY,
+			*Report.Stats.Min.ToString(),
+			*Report.Stats.Max.ToString(),
+			*Report.Stats.Mean.ToString(),
+			Report.bConstantColor,
+			Report.bNonPowerOfTwo,
+			Report.bOversized,
+			Report.bBadMaskPacking,
+			Report.bReadFailed,
+			Report.bFixed
+		);
+	}
+	
+	const FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutoMesh"), ReportFilename);
+	UE_LOG(LogAutoMesh, Warning, TEXT("Writing Report: %s"), *ReportPath);
+	return FFileHelper::SaveStringToFile(ReportCSV, *ReportPath);
+}
+
+FAutoMeshTextureStats AAutoMesh::ComputeTextureStats(const TArrayView64<const FLinearColor> Pixels)
+{
+	FAutoMeshTextureStats Stats;
+	const int64 NumPixels = Pixels.Num();
+	if (NumPixels == 0)
+	{
+		return Stats;
+	}
+
+	struct FChunkStats
+	{
+		FLinearColor Min;
+		FLinearColor Max;
+		FLinearColor Sum;
+		FLinearColor Delta;
+	};
+	const int32 NumChunks = static_cast<int32>(
+		FMath::DivideAndRoundUp(NumPixels, AutoMeshTexture::PixelsPerChunk)
+	);
+	TArray<FChunkStats> Chunks;
+	Chunks.SetNumUninitialized(NumChunks);
+	FAutoMeshProfiler::CountAllocations(Chunks);
+
+	ParallelFor(NumChunks, [&Chunks, &Pixels, NumPixels](const int32 ChunkIndex)
+	{
+		const int64 Begin = ChunkIndex * AutoMeshTexture::PixelsPerChunk;
+		const int64 End = FMath::Min(Begin + AutoMeshTexture::PixelsPerChunk, NumPixels);
+		
+		VectorRegister4Float VMin = VectorSetFloat1(MAX_flt);
+		VectorRegister4Float VMax = VectorSetFloat1(-MAX_flt);
+		VectorRegister4Float VSum = VectorZeroFloat();
+		VectorRegister4Float VDelta = VectorZeroFloat();
+		for (int64 Index = Begin; Index < End; ++Index)
+		{
+			const VectorRegister4Float VPixel = VectorLoad(&Pixels[Index].R);
+			VMin = VectorMin(VMin, VPixel);
+			VMax = VectorMax(VMax, VPixel);
+			VSum = VectorAdd(VSum, VPixel);
+			// RGBA - GBRA yields R-G, G-B, B-R
+			VDelta = VectorMax(VDelta, VectorAbs(VectorSubtract(VPixel, VectorSwizzle(VPixel, 1, 2, 0, 3))));
+		}
+		
+		FChunkStats& Chunk = Chunks[ChunkIndex];
+		VectorStore(VMin, &Chunk.Min.R);
+		VectorStore(VMax, &Chunk.Max.R);
+		VectorStore(VSum, &Chunk.Sum.R);
+		VectorStore(VDelta, &Chunk.Delta.R);
+	});
+
+	// Accumulate chunk sums in double to keep precision on large textures
+	Stats.Min = Chunks[0].Min;
+	Stats.Max = Chunks[0].Max;
+	double SumR = 0.0, SumG = 0.0, SumB = 0.0, SumA = 0.0;
+	for (const FChunkStats& Chunk : Chunks)
+	{
+		Stats.Min = FLinearColor(
+			FMath::Min(Stats.Min.R, Chunk.Min.R),
+			FMath::Min(Stats.Min.G, Chunk.Min.G),
+			FMath::Min(Stats.Min.B, Chunk.Min.B),
+			FMath::Min(Stats.Min.A, Chunk.Min.A)
+		);
+		Stats.Max = FLinearColor(
+			FMath::Max(Stats.Max.R, Chunk.Max.R),
+			FMath::Max(Stats.Max.G, Chunk.Max.G),
+			FMath::Max(Stats.Max.B, Chunk.Max.B),
+			FMath::Max(Stats.Max.A, Chunk.Max.A)
+		);
+		SumR += Chunk.Sum.R;
+		SumG += Chunk.Sum.G;
+		SumB += Chunk.Sum.B;
+		SumA += Chunk.Sum.A;
+		Stats.MaxChannelDelta = FMath::Max3(Stats.MaxChannelDelta, Chunk.Delta.R, FMath::Max(Chunk.Delta.G,
+			Chunk.Delta.B));
+	}
+	Stats.Mean = FLinearColor(
+		static_cast<float>(SumR / NumPixels),
+		static_cast<float>(SumG / NumPixels),
+		static_cast<float>(SumB / NumPixels),
+		static_cast<float>(SumA / NumPixels)
+	);
+	return Stats;
+}
+
+FString AAutoMesh::GetImportPackageName(const FString SourceFilename)
+{
+	checkf(*SourceFilename != nullptr, TEXT("nullptr: SourceFilename"));
+	
+	const FString ObjectName = FPaths::GetBaseFilename(SourceFilename);
+	TArray<FString> ObjectNameArray;
+	ObjectName.ParseIntoArray(
+		ObjectNameArray,
+		TEXT("_"),
+		true
+	);
+
+	// Expect T_[Prop|Structure]_MeshName_[D|M|N]
+	if (ObjectNameArray.Num() < 4
+		|| ObjectNameArray[0] != TEXT("T")
+		|| (ObjectNameArray.Last() != TEXT("D")
+			&& ObjectNameArray.Last() != TEXT("M")
+			&& ObjectNameArray.Last() != TEXT("N")))
+	{
+		return FString();
+	}
+	
+	return FString::Printf(
+		TEXT("/Game/Textures/%s/%s"),
+		*ObjectNameArray[1],
+		*ObjectName
+	);
+}
+
+TArray<UTexture2D*> AAutoMesh::ImportTextures(const FString SourceDir)
+{
+	checkf(*SourceDir != nullptr, TEXT("nullptr: SourceDir"));
+	check(IsInGameThread());
+	AUTOMESH_PROFILE_SCOPE(Import, NAME_None);
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::
+		LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::
+		LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	TArray<FString> SourceFilenames;
+	for (const TCHAR* Extension : {TEXT("*.png"), TEXT("*.tga"), TEXT("*.exr")})
+	{
+		TArray<FString> Filenames;
+		IFileManager::Get().FindFilesRecursive(Filenames, *SourceDir, Extension, true, false);
+		SourceFilenames.Append(Filenames);
+	}
+
+	struct FImportItem
+	{
+		FString SourceFilename;
+		FString PackageName;
+		// Set when a changed source is reimported into an existing texture
+		UTexture2D* ExistingTexture = nullptr;
+		FMD5Hash FileHash;
+		TArray64<uint8> Compressed;
+		// Decoded size from the image header, used to close batches on ImportBatchBytes
+		int64 DecodedBytes = 0;
+		FImage Image;
+		bool bLoaded = false;
+		bool bDecoded = false;
+	};
+	// Sorted so the first of several files mapping to one package is stable between runs
+	SourceFilenames.Sort();
+	TArray<FImportItem> Items;
+	TMap<FString, FString> SourceByPackageName;
+	for (const FString& SourceFilename : SourceFilenames)
+	{
+		const FString PackageName = AAutoMesh::GetImportPackageName(SourceFilename);
+		if (PackageName.IsEmpty())
+		{
+			UE_LOG(LogAutoMesh, Error, TEXT("Invalid Texture Filename: %s"), *SourceFilename);
+			continue;
+		}
+		if (const FString* ExistingSource = SourceByPackageName.Find(PackageName))
+		{
+			UE_LOG(LogAutoMesh, Error, TEXT("Duplicate Texture Source: %s, %s -> %s"), **ExistingSource,
+				*SourceFilename, *PackageName);
+			continue;
+		}
+		
+		UTexture2D* ExistingTexture = nullptr;
+		if (FPackageName::DoesPackageExist(*PackageName))
+		{
+			ExistingTexture = LoadObject<UTexture2D>(
+				nullptr,
+				*(PackageName + TEXT(".") + FPackageName::GetShortName(PackageName))
+			);
+			if (ExistingTexture == nullptr || ExistingTexture->AssetImportData == nullptr)
+			{
+				UE_LOG(LogAutoMesh, Error, TEXT("Existing Package Not Texture: %s"), *PackageName);
+				continue;
+			}
+		}
+		SourceByPackageName.Add(PackageName, SourceFilename);
+		FImportItem& Item = Items.AddDefaulted_GetRef();
+		Item.SourceFilename = SourceFilename;
+		Item.PackageName = PackageName;
+		Item.ExistingTexture = ExistingTexture;
+	}
+
+	// Hash sources of existing textures on worker threads, only edited sources are reimported
+	ParallelFor(Items.Num(), [&Items](const int32 Index)
+	{
+		AUTOMESH_PROFILE_WORKER_SCOPE(Import);
+		FImportItem& Item = Items[Index];
+		if (Item.ExistingTexture != nullptr)
+		{
+			Item.FileHash = FMD5Hash::HashFile(*Item.SourceFilename);
+		}
+	});
+	Items.RemoveAll([](const FImportItem& Item)
+	{
+		if (Item.ExistingTexture == nullptr)
+		{
+			return false;
+		}
+		const TArray<FAssetImportInfo::FSourceFile>& SourceFiles =
+			Item.ExistingTexture->AssetImportData->SourceData.SourceFiles;
+		if (SourceFiles.Num() > 0 && Item.FileHash.IsValid() && SourceFiles[0].FileHash == Item.FileHash)
+		{
+			UE_LOG(LogAutoMesh, Warning, TEXT("Unchanged Texture Source: %s"), *Item.PackageName);
+			return true;
+		}
+		return false;
+	});
+	UE_LOG(LogAutoMesh, Warning, TEXT("Importing %d Textures: %s"), Items.Num(), *SourceDir);
+
+	TArray<UTexture2D*> Textures;
+	int32 BatchBegin = 0;
+	while (BatchBegin < Items.Num())
+	{
+		const int32 WindowEnd = FMath::Min(BatchBegin + AutoMeshTexture::ImportBatchSize, Items.Num());
+		
+		// Read files and decoded size from image headers on worker threads
+		ParallelFor(WindowEnd - BatchBegin, [&Items, &ImageWrapperModule, BatchBegin](const int32 Index)
+		{
+			AUTOMESH_PROFILE_WORKER_SCOPE(Import);
+			FImportItem& Item = Items[BatchBegin + Index];
+			if (Item.bLoaded)
+			{
+				return;
+			}
+			Item.bLoaded = true;
+			if (!FFileHelper::LoadFileToArray(Item.Compressed, *Item.SourceFilename))
+			{
+				return;
+			}
+			FAutoMeshProfiler::CountAllocations(Item.Compressed);
+			
+			// Unreadable header fails to decode anyway, count compressed size only
+			Item.DecodedBytes = Item.Compressed.Num();
+			const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(
+				ImageWrapperModule.DetectImageFormat(Item.Compressed.GetData(), Item.Compressed.Num())
+			);
+			if (ImageWrapper.IsValid() && ImageWrapper->SetCompressed(Item.Compressed.GetData(), Item.Compressed.Num()))
+			{
+				// Image wrapper keeps its own copy of the compressed file
+				FAutoMeshProfiler::CountAllocations(Item.Compressed);
+				Item.DecodedBytes = static_cast<int64>(ImageWrapper->GetWidth()) * ImageWrapper->GetHeight()
+					* ERawImageFormat::GetBytesPerPixel(ImageWrapper->GetClosestRawImageFormat());
+			}
+		});
+
+		// Close batch on decoded byte budget, always take one so an oversized image still imports
+		int32 BatchEnd = BatchBegin + 1;
+		int64 BatchBytes = Items[BatchBegin].DecodedBytes;
+		while (BatchEnd < WindowEnd && BatchBytes + Items[BatchEnd].DecodedBytes <= AutoMeshTexture::ImportBatchBytes)
+		{
+			BatchBytes += Items[BatchEnd].DecodedBytes;
+			++BatchEnd;
+		}
+		
+		// Decode on worker threads, images left in window stay loaded for the next batch
+		ParallelFor(BatchEnd - BatchBegin, [&Items, &ImageWrapperModule, BatchBegin](const int32 Index)
+		{
+			AUTOMESH_PROFILE_WORKER_SCOPE(Import);
+			FImportItem& Item = Items[BatchBegin + Index];
+			if (Item.Compressed.Num() > 0)
+			{
+				Item.bDecoded = ImageWrapperModule.DecompressImage(Item.Compressed.GetData(), Item.Compressed.Num(), Item.Image);
+				FAutoMeshProfiler::CountAllocations(Item.Image.RawData);
+			}
+			Item.Compressed.Empty();
+		});
+
+		// Create or reimport texture assets on game thread
+		for (int32 Index = BatchBegin; Index < BatchEnd; ++Index)
+		{
+			FImportItem& Item = Items[Index];
+			if (!Item.bDecoded)
+			{
+				UE_LOG(LogAutoMesh, Error, TEXT("Decode Failed: %s"), *Item.SourceFilename);
+				continue;
+			}
+
+			// Reimport keeps the settings of the existing texture, only the source pixels change
+			if (Item.ExistingTexture != nullptr)
+			{
+				UE_LOG(LogAutoMesh, Warning, TEXT("Reimporting Asset: %s"), *Item.PackageName);
+				UTexture2D* Texture = Item.ExistingTexture;
+				Texture->Modify();
+				Texture->Source.Init(Item.Image);
+				Texture->AssetImportData->Update(Item.SourceFilename, &Item.FileHash);
+				Texture->PostEditChange();
+				AAutoMesh::SaveAsset(Texture);
+				Textures.Add(Texture);
+				Item.Image = FImage();
+				continue;
+			}
+
+			UE_LOG(LogAutoMesh, Warning, TEXT("Creating Asset: %s"), *Item.PackageName);
+			UPackage* Package = CreatePackage(*Item.PackageName);
+			UTexture2D* Texture = NewObject<UTexture2D>(
+				Package,
+				*FPackageName::GetShortName(Item.PackageName),
+				RF_Public | RF_Standalone | RF_Transactional
+			);
+			checkf(Texture != nullptr, TEXT("nullptr: Texture"));
+			Texture->Source.Init(Item.Image);
+
+			// Apply UE standard settings from texture suffix
+			const TCHAR Suffix = Item.PackageName[Item.PackageName.Len() - 1];
+			if (Suffix == TEXT('M'))
+			{
+				Texture->SRGB = false;
+				Texture->CompressionSettings = TC_Masks;
+			}
+			else if (Suffix == TEXT('N'))
+			{
+				Texture->SRGB = false;
+				Texture->CompressionSettings = TC_Normalmap;
+				Texture->LODGroup = TEXTUREGROUP_WorldNormalMap;
+			}
+			else
+			{
+				Texture->SRGB = Item.Image.GammaSpace == EGammaSpace::sRGB;
+				Texture->CompressionSettings = TC_Default;
+			}
+			
+			// Float sources keep their range, as the engine texture factory does for HDR data
+			if (Item.Image.Format == ERawImageFormat::RGBA16F
+				|| Item.Image.Format == ERawImageFormat::RGBA32F
+				|| Item.Image.Format == ERawImageFormat::R16F
+				|| Item.Image.Format == ERawImageFormat::R32F)
+			{
+				Texture->SRGB = false;
+				Texture->CompressionSettings = TC_HDR;
+			}
+			Texture->AssetImportData->Update(Item.SourceFilename);
+			Texture->PostEditChange();
+			AAutoMesh::SaveAsset(Texture);
+			AssetRegistryModule.AssetCreated(Texture);
+			Textures.Add(Texture);
+			
+			// Release decoded pixels, the texture source owns a copy
+			Item.Image = FImage();
+		}
+		BatchBegin = BatchEnd;
+	}
+	return Textures;
+}
+
+bool AAutoMesh::SaveAsset(UObject* Asset)
+{
+	checkf(Asset != nullptr, TEXT("nullptr: Asset"));
+	
+	UPackage* Package = Asset->GetOutermost();
+	const FString PackageName = Package->GetName();
+	UE_LOG(LogAutoMesh, Warning, TEXT("Saving Package: %s"), *PackageName);
+	return UPackage::Save(
+		Package,
+		Asset,
+		RF_Public | RF_Standalone,
+		*FPackageName::LongPackageNameToFilename(
+			*PackageName,
+			*FPackageName::GetAssetPackageExtension()
+		)
+	).IsSuccessful();
+}
+
+FString AAutoMesh::GetJournalRunKey(TArray<FString> StaticMeshPackageNames)
+{
+	StaticMeshPackageNames.Sort();
+	return FString::Printf(
+		TEXT("%08x"),
+		FCrc::StrCrc32(*FString::Join(StaticMeshPackageNames, TEXT("\n")))
+	);
+}
+
+TSet<FString> AAutoMesh::LoadJournal(const FString JournalFilename, const FString RunKey)
+{
+	checkf(*JournalFilename != nullptr, TEXT("nullptr: JournalFilename"));
+	
+	TSet<FString> Completed;
+	FString Journal;
+	if (!FFileHelper::LoadFileToString(Journal, *AutoMeshJournal::GetJournalPath(JournalFilename)))
+	{
+		return Completed;
+	}
+
+	TArray<FString> Records;
+	Journal.ParseIntoArray(
+		Records,
+		TEXT("\n"),
+		true
+	);
+	// Drop record truncated by a crash mid-write
+	if (Records.Num() > 0 && !Journal.EndsWith(TEXT("\n")))
+	{
+		Records.Pop();
+	}
+	
+	// Journal of a different input set does not apply to this run
+	if (Records.Num() == 0 || Records[0] != AutoMeshJournal::RunKeyPrefix + RunKey)
+	{
+		return Completed;
+	}
+	Records.RemoveAt(0);
+	Completed.Append(Records);
+	return Completed;
+}
+
+bool AAutoMesh::WriteJournal(const FString& JournalFilename, const FString& RunKey, const TSet<FString>& Completed)
+{
+	checkf(*JournalFilename != nullptr, TEXT("nullptr: JournalFilename"));
+	
+	FString Journal = AutoMeshJournal::RunKeyPrefix + RunKey + TEXT("\n");
+	for (const FString& Record : Completed)
+	{
+		Journal += Record + TEXT("\n");
+	}
+	
+	// Replace journal by move, a crash mid-write only loses the temporary file
+	const FString JournalPath = AutoMeshJournal::GetJournalPath(JournalFilename);
+	const FString TempJournalPath = JournalPath + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(
+		Journal,
+		*TempJournalPath,
+		FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		return false;
+	}
+	return IFileManager::Get().Move(*JournalPath, *TempJournalPath, true, true);
+}
+
+TArray<UStaticMesh*> AAutoMesh::ProcessStaticMeshes(const TArray<UObject*>& StaticMeshObjects,
+	const FString JournalFilename, const bool bFresh, const bool bValidate, const int32 MaxTextureSize,
+	const bool bAutoFix)
+{
+	checkf(*JournalFilename != nullptr, TEXT("nullptr: JournalFilename"));
+	
+	TArray<UStaticMesh*> StaticMeshes;
+	TArray<FString> StaticMeshPackageNames;
+	for (UObject* StaticMeshObject : StaticMeshObjects)
+	{
+		UStaticMesh* StaticMesh = AAutoMesh::GetStaticMesh(StaticMeshObject);
+		if (StaticMesh != nullptr)
+		{
+			StaticMeshes.Add(StaticMesh);
+			StaticMeshPackageNames.Add(StaticMesh->GetOutermost()->GetName());
+		}
+	}
+	
+	const FString JournalPath = AutoMeshJournal::GetJournalPath(JournalFilename);
+	const FString RunKey = AAutoMesh::GetJournalRunKey(StaticMeshPackageNames);
+	// Journal of a different input set is rejected by its run key
+	TSet<FString> Completed;
+	if (!bFresh)
+	{
+		Completed = AAutoMesh::LoadJournal(JournalFilename, RunKey);
+		if (Completed.Num() > 0)
+		{
+			UE_LOG(LogAutoMesh, Warning, TEXT("Resuming Journal: %s (%d completed)"), *JournalPath,
+				Completed.Num());
+		}
+	}
+	
+	// Rewrite journal so appended records never follow a truncated one
+	if (!AAutoMesh::WriteJournal(JournalFilename, RunKey, Completed))
+	{
+		UE_LOG(LogAutoMesh, Error, TEXT("Cannot Write Journal: %s"), *JournalPath);
+		return TArray<UStaticMesh*>();
+	}
+	TUniquePtr<FArchive> JournalWriter(IFileManager::Get().CreateFileWriter(*JournalPath, FILEWRITE_Append));
+	if (!JournalWriter)
+	{
+		UE_LOG(LogAutoMesh, Error, TEXT("Cannot Open Journal: %s"), *JournalPath);
+		return TArray<UStaticMesh*>();
+	}
+
+	FScopedSlowTask SlowTask(
+		StaticMeshes.Num(),
+		FText::FromString(TEXT("AutoMesh: Processing Static Meshes"))
+	);
+	SlowTask.MakeDialog(true);
+
+	TArray<UStaticMesh*> Processed;
+	TArray<FAutoMeshTextureReport> TextureReports;
+	bool bCancelled = false;
+	for (int32 Index = 0; Index < StaticMeshes.Num(); ++Index)
+	{
+		SlowTask.EnterProgressFrame();
+		if (SlowTask.ShouldCancel())
+		{
+			bCancelled = true;
+			break;
+		}
+		
+		UStaticMesh* StaticMesh = StaticMeshes[Index];
+		const FString& StaticMeshPackageName = StaticMeshPackageNames[Index];
+		if (Completed.Contains(StaticMeshPackageName))
+		{
+			continue;
+		}
+
+		// Check textures before AddTexturesToMIC binds them
+		if (bValidate)
+		{
+			TextureReports.Append(AAutoMesh::ValidateTextures(StaticMesh, MaxTextureSize, bAutoFix));
+		}
+
+		UMaterial* MasterMaterial = AAutoMesh::CreateMasterMaterial(StaticMesh);
+		UMaterialInstanceConstant* MaterialInstance = AAutoMesh::CreateMaterialInstance(MasterMaterial, StaticMesh);
+		AAutoMesh::AssignMaterial(MaterialInstance, StaticMesh);
+
+		// Record only after packages are on disk so a resumed run never skips unsaved work
+		{
+			AUTOMESH_PROFILE_SCOPE(Save, StaticMesh->GetOutermost()->GetFName());
+			if (!AAutoMesh::SaveAsset(MaterialInstance) || !AAutoMesh::SaveAsset(StaticMesh))
+			{
+				UE_LOG(LogAutoMesh, Error, TEXT("Save Failed: %s"), *StaticMeshPackageName);
+				continue;
+			}
+		}
+		FTCHARToUTF8 Record(*(StaticMeshPackageName + TEXT("\n")));
+		JournalWriter->Serialize(const_cast<ANSICHAR*>(Record.Get()), Record.Length());
+		JournalWriter->Flush();
+		
+		Completed.Add(StaticMeshPackageName);
+		Processed.Add(StaticMesh);
+	}
+	JournalWriter->Close();
+	JournalWriter.Reset();
+
+	if (TextureReports.Num() > 0)
+	{
+		AAutoMesh::WriteTextureReport(
+			TextureReports,
+			FPaths::GetBaseFilename(JournalFilename) + TEXT("_TextureReport.csv")
+		);
+	}
+
+	// Keep journal of cancelled run for resume, a completed run starts fresh next time
+	if (!bCancelled)
+	{
+		IFileManager::Get().Delete(*JournalPath, false, false, true);
+	}
+	UE_LOG(LogAutoMesh, Warning, TEXT("Processed %d Static Meshes%s"), Processed.Num(),
+		bCancelled ? TEXT(" (cancelled)") : TEXT(""));
+	return Processed;
+}
+
+TArray<FString> AAutoMesh::GetImpactedStaticMeshes(const TArray<FString>& ChangedPackageNames)
+{
+	TArray<FName> ChangedNames;
+	for (const FString& ChangedPackageName : ChangedPackageNames)
+	{
+		ChangedNames.Add(FName(ChangedPackageName));
+	}
+	
+	TSet<FName> StaticMeshes;
+	TSet<FName> MaterialInstances;
+	FAutoMeshDependencyIndex::Get().GetImpactedPackages(ChangedNames, StaticMeshes, MaterialInstances);
+	
+	TArray<FString> StaticMeshPackageNames;
+	for (const FName StaticMesh : StaticMeshes)
+	{
+		StaticMeshPackageNames.Add(StaticMesh.ToString());
+	}
+	StaticMeshPackageNames.Sort();
+	UE_LOG(LogAutoMesh, Warning, TEXT("Impacted: %d Static Meshes, %d Material Instances"), StaticMeshes.Num(),
+		MaterialInstances.Num());
+	return StaticMeshPackageNames;
+}
+
+TArray<UStaticMesh*> AAutoMesh::ProcessChangedPackages(const TArray<FString>& ChangedPackageNames,
+	const FString JournalFilename, const bool bFresh)
+{
+	TArray<UObject*> StaticMeshObjects;
+	for (const FString& StaticMeshPackageName : AAutoMesh::GetImpactedStaticMeshes(ChangedPackageNames))
+	{
+		UStaticMesh* StaticMesh = LoadObject<UStaticMesh>(
+			nullptr,
+			*(StaticMeshPackageName + TEXT(".") + FPackageName::GetShortName(StaticMeshPackageName))
+		);
+		if (StaticMesh == nullptr)
+		{
+			UE_LOG(LogAutoMesh, Error, TEXT("Not Exists: %s"), *StaticMeshPackageName);
+			continue;
+		}
+		StaticMeshObjects.Add(StaticMesh);
+	}
+	return AAutoMesh::ProcessStaticMeshes(StaticMeshObjects, JournalFilename, bFresh);
+}
+
+void AAutoMesh::BeginProfiling()
+{
+	FAutoMeshProfiler::Get().BeginSession();
+}
+
+bool AAutoMesh::EndProfiling(const FString ReportFilename)
+{
+	checkf(*ReportFilename != nullptr, TEXT("nullptr: ReportFilename"));
+	
+	return FAutoMeshProfiler::Get().EndSession(ReportFilename);
+}
+
+void AAutoMesh::ResetFactoryPool()
+{
+	AutoMeshFactory::Pool.Reset();
+}
+
+TArray<UStaticMesh*> AAutoMesh::ImportAndProcessTextures(const FString SourceDir, const FString JournalFilename,
+	const bool bFresh)
+{
+	TArray<FString> TexturePackageNames;
+	for (const UTexture2D* Texture : AAutoMesh::ImportTextures(SourceDir))
+	{
+		TexturePackageNames.Add(Texture->GetOutermost()->GetName());
+	}
+	return AAutoMesh::ProcessChangedPackages(TexturePackageNames, JournalFilename, bFresh);
+}
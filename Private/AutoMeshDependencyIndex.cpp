@@ -0,0 +1,268 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AutoMeshDependencyIndex.h"
+
+#include "AutoMesh.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+
+namespace AutoMeshDependencyIndex
+{
+	TUniquePtr<FAutoMeshDependencyIndex> Instance;
+
+	bool HasPrefix(const FString& ObjectName, const TCHAR* Prefix)
+	{
+		return ObjectName.StartsWith(Prefix, ESearchCase::CaseSensitive);
+	}
+}
+
+FAutoMeshDependencyIndex::FAutoMeshDependencyIndex()
+{
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::
+		LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	AssetRegistry = &AssetRegistryModule.Get();
+	
+	AddedHandle = AssetRegistry->OnAssetAdded().AddRaw(this, &FAutoMeshDependencyIndex::OnAssetChanged);
+	RemovedHandle = AssetRegistry->OnAssetRemoved().AddRaw(this, &FAutoMeshDependencyIndex::OnAssetChanged);
+	RenamedHandle = AssetRegistry->OnAssetRenamed().AddRaw(this, &FAutoMeshDependencyIndex::OnAssetRenamed);
+	UpdatedHandle = AssetRegistry->OnAssetUpdated().AddRaw(this, &FAutoMeshDependencyIndex::OnAssetChanged);
+}
+
+FAutoMeshDependencyIndex::~FAutoMeshDependencyIndex()
+{
+	// Registry may already be gone during engine shutdown
+	if (FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")))
+	{
+		AssetRegistry->OnAssetAdded().Remove(AddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(RemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(RenamedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(UpdatedHandle);
+	}
+}
+
+FAutoMeshDependencyIndex& FAutoMeshDependencyIndex::Get()
+{
+	check(IsInGameThread());
+	
+	if (!AutoMeshDependencyIndex::Instance)
+	{
+		AutoMeshDependencyIndex::Instance = MakeUnique<FAutoMeshDependencyIndex>();
+	}
+	return *AutoMeshDependencyIndex::Instance;
+}
+
+void FAutoMeshDependencyIndex::Shutdown()
+{
+	AutoMeshDependencyIndex::Instance.Reset();
+}
+
+void FAutoMeshDependencyIndex::GetImpactedPackages(const TArray<FName>& ChangedPackageNames,
+	TSet<FName>& OutStaticMeshes, TSet<FName>& OutMaterialInstances)
+{
+	check(IsInGameThread());
+	
+	if (AssetRegistry->IsLoadingAssets())
+	{
+		UE_LOG(LogAutoMesh, Warning, TEXT("Waiting For Asset Registry"));
+		AssetRegistry->WaitForCompletion();
+	}
+	
+	for (const FName ChangedPackageName : ChangedPackageNames)
+	{
+		const FImpact& Impact = FindOrBuildImpact(ChangedPackageName);
+		OutStaticMeshes.Append(Impact.StaticMeshes);
+		OutMaterialInstances.Append(Impact.MaterialInstances);
+	}
+}
+
+FName FAutoMeshDependencyIndex::GetStaticMeshPackageName(const FName PackageName)
+{
+	const FString PackageNameStr = PackageName.ToString();
+	const FString PackagePath = FPackageName::GetLongPackagePath(PackageNameStr);
+	const FString ObjectName = FPackageName::GetShortName(PackageNameStr);
+
+	// e.g.: /Game/Textures/Prop/T_Prop_MeshName_D -> /Game/Meshes/Prop/SM_Prop_MeshName
+	if (AutoMeshDependencyIndex::HasPrefix(ObjectName, TEXT("T_")))
+	{
+		TArray<FString> ObjectNameArray;
+		ObjectName.ParseIntoArray(
+			ObjectNameArray,
+			TEXT("_"),
+			true
+		);
+		if (ObjectNameArray.Num() < 4
+			|| (ObjectNameArray.Last() != TEXT("D")
+				&& ObjectNameArray.Last() != TEXT("M")
+				&& ObjectNameArray.Last() != TEXT("N")))
+		{
+			return NAME_None;
+		}
+		return FName(
+			PackagePath.Replace(TEXT("Textures"), TEXT("Meshes"))
+			+ TEXT("/SM_")
+			+ ObjectName.Mid(2, ObjectName.Len() - 4)  // Strip "T_" prefix and "_[D|M|N]" suffix
+		);
+	}
+	
+	// e.g.: /Game/Materials/Prop/MI_Prop_MeshName -> /Game/Meshes/Prop/SM_Prop_MeshName
+	if (AutoMeshDependencyIndex::HasPrefix(ObjectName, TEXT("MI_")))
+	{
+		return FName(
+			PackagePath.Replace(TEXT("Materials"), TEXT("Meshes"))
+			+ TEXT("/SM_")
+			+ ObjectName.Mid(3)
+		);
+	}
+	return NAME_None;
+}
+
+const FAutoMeshDependencyIndex::FImpact& FAutoMeshDependencyIndex::FindOrBuildImpact(const FName PackageName)
+{
+	if (const FImpact* CachedImpact = Impacts.Find(PackageName))
+	{
+		return *CachedImpact;
+	}
+
+	FImpact Impact;
+	TArray<FName> Pending;
+	Impact.Visited.Add(PackageName);
+	Pending.Add(PackageName);
+	auto Visit = [&Impact, &Pending](const FName Name)
+	{
+		bool bAlreadyVisited = false;
+		Impact.Visited.Add(Name, &bAlreadyVisited);
+		if (!bAlreadyVisited)
+		{
+			Pending.Add(Name);
+		}
+	};
+
+	// Walk referencers from textures through M_ and MI_ up to SM_ packages
+	TArray<FName> Referencers;
+	while (Pending.Num() > 0)
+	{
+		const FName Current = Pending.Pop();
+		const FString ObjectName = FPackageName::GetShortName(Current);
+		if (AutoMeshDependencyIndex::HasPrefix(ObjectName, TEXT("SM_")))
+		{
+			if (DoesPackageExist(Current))
+			{
+				Impact.StaticMeshes.Add(Current);
+			}
+			continue;
+		}
+		if (AutoMeshDependencyIndex::HasPrefix(ObjectName, TEXT("MI_")) && DoesPackageExist(Current))
+		{
+			Impact.MaterialInstances.Add(Current);
+		}
+
+		const FName DerivedStaticMesh = GetStaticMeshPackageName(Current);
+		if (!DerivedStaticMesh.IsNone())
+		{
+			Visit(DerivedStaticMesh);
+		}
+		
+		Referencers.Reset();
+		GetReferencers(Current, Referencers);
+		for (const FName Referencer : Referencers)
+		{
+			const FString ReferencerName = FPackageName::GetShortName(Referencer);
+			if (AutoMeshDependencyIndex::HasPrefix(ReferencerName, TEXT("SM_"))
+				|| AutoMeshDependencyIndex::HasPrefix(ReferencerName, TEXT("MI_"))
+				|| AutoMeshDependencyIndex::HasPrefix(ReferencerName, TEXT("M_")))
+			{
+				Visit(Referencer);
+			}
+		}
+	}
+
+	for (const FName VisitedName : Impact.Visited)
+	{
+		VisitedBy.FindOrAdd(VisitedName).Add(PackageName);
+	}
+	return Impacts.Add(PackageName, MoveTemp(Impact));
+}
+
+bool FAutoMeshDependencyIndex::IsCached(const FName PackageName) const
+{
+	return Impacts.Contains(PackageName);
+}
+
+void FAutoMeshDependencyIndex::GetReferencers(const FName PackageName, TArray<FName>& OutReferencers) const
+{
+	AssetRegistry->GetReferencers(PackageName, OutReferencers, UE::AssetRegistry::EDependencyCategory::Package);
+}
+
+void FAutoMeshDependencyIndex::GetDependencies(const FName PackageName, TArray<FName>& OutDependencies) const
+{
+	AssetRegistry->GetDependencies(PackageName, OutDependencies, UE::AssetRegistry::EDependencyCategory::Package);
+}
+
+bool FAutoMeshDependencyIndex::DoesPackageExist(const FName PackageName) const
+{
+	// In-memory registry lookup, avoids a filesystem hit per visited package
+	TArray<FAssetData> Assets;
+	AssetRegistry->GetAssetsByPackageName(PackageName, Assets);
+	return Assets.Num() > 0;
+}
+
+void FAutoMeshDependencyIndex::Invalidate(const FName PackageName)
+{
+	TSet<FName> ImpactNames;
+	if (!VisitedBy.RemoveAndCopyValue(PackageName, ImpactNames))
+	{
+		return;
+	}
+	
+	for (const FName ImpactName : ImpactNames)
+	{
+		FImpact Impact;
+		if (!Impacts.RemoveAndCopyValue(ImpactName, Impact))
+		{
+			continue;
+		}
+		for (const FName VisitedName : Impact.Visited)
+		{
+			if (TSet<FName>* VisitedImpacts = VisitedBy.Find(VisitedName))
+			{
+				VisitedImpacts->Remove(ImpactName);
+			}
+		}
+	}
+}
+
+void FAutoMeshDependencyIndex::NotifyPackageChanged(const FName PackageName)
+{
+	// Nothing cached during the initial registry scan
+	if (Impacts.Num() == 0)
+	{
+		return;
+	}
+	
+	Invalidate(PackageName);
+
+	// A new or changed referencer invalidates entries which walked through its dependencies
+	TArray<FName> Dependencies;
+	GetDependencies(PackageName, Dependencies);
+	for (const FName Dependency : Dependencies)
+	{
+		Invalidate(Dependency);
+	}
+}
+
+void FAutoMeshDependencyIndex::OnAssetChanged(const FAssetData& AssetData)
+{
+	NotifyPackageChanged(AssetData.PackageName);
+}
+
+void FAutoMeshDependencyIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (Impacts.Num() == 0)
+	{
+		return;
+	}
+	
+	Invalidate(FName(FPackageName::ObjectPathToPackageName(OldObjectPath)));
+	NotifyPackageChanged(AssetData.PackageName);
+}
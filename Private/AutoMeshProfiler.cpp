@@ -0,0 +1,238 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AutoMeshProfiler.h"
+
+#include "AutoMesh.h"
+#include "Misc/FileHelper.h"
+
+LLM_DEFINE_TAG(AutoMesh_Import);
+LLM_DEFINE_TAG(AutoMesh_Validate);
+LLM_DEFINE_TAG(AutoMesh_MasterMaterial);
+LLM_DEFINE_TAG(AutoMesh_MaterialInstance);
+LLM_DEFINE_TAG(AutoMesh_Textures);
+LLM_DEFINE_TAG(AutoMesh_Assign);
+LLM_DEFINE_TAG(AutoMesh_Save);
+
+namespace AutoMeshProfiler
+{
+	TUniquePtr<FAutoMeshProfiler> Instance;
+
+	// Allocations counted by the calling thread, only while a scope enables counting
+	thread_local bool bCounting = false;
+	thread_local uint64 AllocatedBytes = 0;
+	thread_local uint64 Allocations = 0;
+}
+
+FAutoMeshProfiler::FScope::FScope(const TCHAR* InStage, const FName InMeshName)
+	: Stage(InStage)
+	, MeshName(InMeshName)
+{
+	// Worker thread scopes only get LLM and trace tags, use AUTOMESH_PROFILE_WORKER_SCOPE in worker bodies
+	if (!AutoMeshProfiler::Instance || !AutoMeshProfiler::Instance->IsActive() || !IsInGameThread())
+	{
+		return;
+	}
+	
+	FAutoMeshProfiler& Profiler = *AutoMeshProfiler::Instance;
+	bActive = true;
+	bWasCounting = AutoMeshProfiler::bCounting;
+	AutoMeshProfiler::bCounting = true;
+	Parent = Profiler.CurrentScope;
+	Profiler.CurrentScope = this;
+	Start = Profiler.GetCounters();
+}
+
+FAutoMeshProfiler::FScope::~FScope()
+{
+	if (!bActive)
+	{
+		return;
+	}
+	AutoMeshProfiler::bCounting = bWasCounting;
+	if (!AutoMeshProfiler::Instance || !AutoMeshProfiler::Instance->IsActive())
+	{
+		return;
+	}
+	
+	FAutoMeshProfiler& Profiler = *AutoMeshProfiler::Instance;
+	const FStageStats End = Profiler.GetCounters();
+	FStageStats Inclusive;
+	Inclusive.Bytes = End.Bytes - Start.Bytes;
+	Inclusive.Allocations = End.Allocations - Start.Allocations;
+	Inclusive.UObjects = End.UObjects - Start.UObjects;
+
+	// Counters are global to the game thread, subtract what nested scopes already recorded
+	FStageStats& Stats = Profiler.Stages.FindOrAdd(Stage).FindOrAdd(MeshName);
+	Stats.Calls++;
+	Stats.Bytes += Inclusive.Bytes - FMath::Min(Children.Bytes, Inclusive.Bytes);
+	Stats.Allocations += Inclusive.Allocations - FMath::Min(Children.Allocations, Inclusive.Allocations);
+	Stats.UObjects += Inclusive.UObjects - FMath::Min(Children.UObjects, Inclusive.UObjects);
+
+	if (Parent != nullptr)
+	{
+		Parent->Children.Bytes += Inclusive.Bytes;
+		Parent->Children.Allocations += Inclusive.Allocations;
+		Parent->Children.UObjects += Inclusive.UObjects;
+	}
+	Profiler.CurrentScope = Parent;
+}
+
+FAutoMeshProfiler::FWorkerScope::FWorkerScope()
+{
+	// Game thread is already counted by the scope running the ParallelFor
+	if (!AutoMeshProfiler::Instance || !AutoMeshProfiler::Instance->IsActive() || IsInGameThread())
+	{
+		return;
+	}
+	
+	bActive = true;
+	bWasCounting = AutoMeshProfiler::bCounting;
+	AutoMeshProfiler::bCounting = true;
+	StartBytes = AutoMeshProfiler::AllocatedBytes;
+	StartAllocations = AutoMeshProfiler::Allocations;
+}
+
+FAutoMeshProfiler::FWorkerScope::~FWorkerScope()
+{
+	if (!bActive)
+	{
+		return;
+	}
+	AutoMeshProfiler::bCounting = bWasCounting;
+	if (!AutoMeshProfiler::Instance)
+	{
+		return;
+	}
+	
+	// Workers nested in another worker scope publish once, from the outermost scope
+	if (!bWasCounting)
+	{
+		FAutoMeshProfiler& Profiler = *AutoMeshProfiler::Instance;
+		Profiler.WorkerBytes.fetch_add(AutoMeshProfiler::AllocatedBytes - StartBytes, std::memory_order_relaxed);
+		Profiler.WorkerAllocations.fetch_add(AutoMeshProfiler::Allocations - StartAllocations, std::memory_order_relaxed);
+	}
+}
+
+FAutoMeshProfiler::~FAutoMeshProfiler()
+{
+	if (bActive)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+	}
+}
+
+FAutoMeshProfiler& FAutoMeshProfiler::Get()
+{
+	check(IsInGameThread());
+	
+	if (!AutoMeshProfiler::Instance)
+	{
+		AutoMeshProfiler::Instance = MakeUnique<FAutoMeshProfiler>();
+	}
+	return *AutoMeshProfiler::Instance;
+}
+
+void FAutoMeshProfiler::Shutdown()
+{
+	AutoMeshProfiler::Instance.Reset();
+}
+
+void FAutoMeshProfiler::BeginSession()
+{
+	check(IsInGameThread());
+	
+	if (!bActive)
+	{
+		GUObjectArray.AddUObjectCreateListener(this);
+	}
+	
+	Stages.Reset();
+	CurrentScope = nullptr;
+	bActive = true;
+}
+
+bool FAutoMeshProfiler::EndSession(const FString& ReportFilename)
+{
+	check(IsInGameThread());
+	
+	if (!bActive)
+	{
+		UE_LOG(LogAutoMesh, Error, TEXT("No Active Profiling Session"));
+		return false;
+	}
+	GUObjectArray.RemoveUObjectCreateListener(this);
+	bActive = false;
+	CurrentScope = nullptr;
+
+	FString ReportCSV = TEXT("Stage,Mesh,Calls,Bytes,Allocations,UObjects\n");
+	for (const TPair<FString, TMap<FName, FStageStats>>& Stage : Stages)
+	{
+		FStageStats Total;
+		for (const TPair<FName, FStageStats>& Mesh : Stage.Value)
+		{
+			ReportCSV += FString::Printf(
+				TEXT("%s,%s,%d,%llu,%llu,%llu\n"),
+				*Stage.Key,
+				*Mesh.Key.ToString(),
+				Mesh.Value.Calls,
+				Mesh.Value.Bytes,
+				Mesh.Value.Allocations,
+				Mesh.Value.UObjects
+			);
+			Total.Calls += Mesh.Value.Calls;
+			Total.Bytes += Mesh.Value.Bytes;
+			Total.Allocations += Mesh.Value.Allocations;
+			Total.UObjects += Mesh.Value.UObjects;
+		}
+		UE_LOG(LogAutoMesh, Warning, TEXT("Stage %s: %d calls, %llu bytes, %llu allocations, %llu UObjects"),
+			*Stage.Key, Total.Calls, Total.Bytes, Total.Allocations, Total.UObjects);
+	}
+
+	const FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutoMesh"), ReportFilename);
+	UE_LOG(LogAutoMesh, Warning, TEXT("Writing Report: %s"), *ReportPath);
+	return FFileHelper::SaveStringToFile(ReportCSV, *ReportPath);
+}
+
+void FAutoMeshProfiler::NotifyUObjectCreated(const UObjectBase* /*Object*/, int32 /*Index*/)
+{
+	UObjectsCreated.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FAutoMeshProfiler::OnUObjectArrayShutdown()
+{
+	GUObjectArray.RemoveUObjectCreateListener(this);
+	bActive = false;
+}
+
+FAutoMeshProfiler::FStageStats FAutoMeshProfiler::GetStageStats(const FString& Stage, const FName MeshName) const
+{
+	if (const TMap<FName, FStageStats>* Meshes = Stages.Find(Stage))
+	{
+		if (const FStageStats* Stats = Meshes->Find(MeshName))
+		{
+			return *Stats;
+		}
+	}
+	return FStageStats();
+}
+
+void FAutoMeshProfiler::CountAllocation(const int64 Bytes)
+{
+	if (AutoMeshProfiler::bCounting && Bytes > 0)
+	{
+		AutoMeshProfiler::AllocatedBytes += Bytes;
+		AutoMeshProfiler::Allocations++;
+	}
+}
+
+FAutoMeshProfiler::FStageStats FAutoMeshProfiler::GetCounters() const
+{
+	check(IsInGameThread());
+	
+	FStageStats Counters;
+	Counters.Bytes = AutoMeshProfiler::AllocatedBytes + WorkerBytes.load(std::memory_order_relaxed);
+	Counters.Allocations = AutoMeshProfiler::Allocations + WorkerAllocations.load(std::memory_order_relaxed);
+	Counters.UObjects = UObjectsCreated.load(std::memory_order_relaxed);
+	return Counters;
+}
@@ -4,8 +4,12 @@
 #include "Tests/AutoMeshTest.h"
 
 #include "AutoMesh.h"
+#include "AutoMeshDependencyIndex.h"
+#include "AutoMeshProfiler.h"
+#include "Async/ParallelFor.h"
 #include "Engine/StaticMeshActor.h"
 #include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
 #include "Tests/AutomationEditorCommon.h"
 
 BEGIN_DEFINE_SPEC(
@@ -152,3 +156,509 @@ void SpecGetStaticMesh::Define()
 		});
 	});
 }
+
+BEGIN_DEFINE_SPEC(
+	SpecComputeTextureStats,
+	"Texturematica.AutoMesh.SpecComputeTextureStats",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+	TArray64<FLinearColor> Pixels;
+END_DEFINE_SPEC(SpecComputeTextureStats)
+
+void SpecComputeTextureStats::Define()
+{
+	Describe("Execute()", [this]()
+	{
+		It("should return equal min, max, mean for constant pixels", [this]()
+		{
+			Pixels.Init(FLinearColor(0.25f, 0.5f, 0.75f, 1.0f), 300 * 1000);
+			FAutoMeshTextureStats Stats = AAutoMesh::ComputeTextureStats(Pixels);
+			TestEqual(TEXT("Testing Min"), Stats.Min, FLinearColor(0.25f, 0.5f, 0.75f, 1.0f));
+			TestEqual(TEXT("Testing Max"), Stats.Max, FLinearColor(0.25f, 0.5f, 0.75f, 1.0f));
+			TestTrue(TEXT("Testing Mean"), Stats.Mean.Equals(FLinearColor(0.25f, 0.5f, 0.75f, 1.0f)));
+			TestEqual(TEXT("Testing MaxChannelDelta"), Stats.MaxChannelDelta, 0.5f);
+		});
+
+		It("should return range and mean across chunks", [this]()
+		{
+			Pixels.Init(FLinearColor(0.0f, 0.0f, 0.0f, 0.0f), 300 * 1000);
+			for (int64 Index = Pixels.Num() / 2; Index < Pixels.Num(); ++Index)
+			{
+				Pixels[Index] = FLinearColor(1.0f, 1.0f, 1.0f, 1.0f);
+			}
+			FAutoMeshTextureStats Stats = AAutoMesh::ComputeTextureStats(Pixels);
+			TestEqual(TEXT("Testing Min"), Stats.Min, FLinearColor(0.0f, 0.0f, 0.0f, 0.0f));
+			TestEqual(TEXT("Testing Max"), Stats.Max, FLinearColor(1.0f, 1.0f, 1.0f, 1.0f));
+			TestTrue(TEXT("Testing Mean"), Stats.Mean.Equals(FLinearColor(0.5f, 0.5f, 0.5f, 0.5f)));
+			TestEqual(TEXT("Testing MaxChannelDelta"), Stats.MaxChannelDelta, 0.0f);
+		});
+	});
+}
+
+BEGIN_DEFINE_SPEC(
+	SpecGetImportPackageName,
+	"Texturematica.AutoMesh.SpecGetImportPackageName",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+END_DEFINE_SPEC(SpecGetImportPackageName)
+
+void SpecGetImportPackageName::Define()
+{
+	Describe("Execute()", [this]()
+	{
+		It("should return texture package name from source filename", [this]()
+		{
+			TestEqual(
+				TEXT("Testing Prop Diffuse"),
+				AAutoMesh::GetImportPackageName(TEXT("/Drop/Prop/T_Prop_Desk_D.png")),
+				TEXT("/Game/Textures/Prop/T_Prop_Desk_D")
+			);
+			TestEqual(
+				TEXT("Testing Structure Mask"),
+				AAutoMesh::GetImportPackageName(TEXT("/Drop/T_Structure_Wall_Trim_M.tga")),
+				TEXT("/Game/Textures/Structure/T_Structure_Wall_Trim_M")
+			);
+		});
+
+		It("should return empty string from non-texture filename", [this]()
+		{
+			TestTrue(TEXT("Testing No Prefix"), AAutoMesh::GetImportPackageName(TEXT("/Drop/Prop_Desk_D.png")).IsEmpty());
+			TestTrue(TEXT("Testing Bad Suffix"), AAutoMesh::GetImportPackageName(TEXT("/Drop/T_Prop_Desk_R.exr")).IsEmpty());
+		});
+	});
+}
+
+BEGIN_DEFINE_SPEC(
+	SpecLoadJournal,
+	"Texturematica.AutoMesh.SpecLoadJournal",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+	FString JournalFilename;
+	FString JournalPath;
+	FString RunKey;
+END_DEFINE_SPEC(SpecLoadJournal)
+
+void SpecLoadJournal::Define()
+{
+	Describe("Execute()", [this]()
+	{
+		BeforeEach([this]()
+		{
+			JournalFilename = TEXT("SpecLoadJournal.journal");
+			JournalPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutoMesh"), JournalFilename);
+			RunKey = AAutoMesh::GetJournalRunKey({
+				TEXT("/Game/Meshes/Prop/SM_Prop_Lamp"),
+				TEXT("/Game/Meshes/Prop/SM_Prop_Desk"),
+				TEXT("/Game/Meshes/Prop/SM_Prop_Chair")
+			});
+		});
+
+		It("should return completed records and drop truncated record", [this]()
+		{
+			FFileHelper::SaveStringToFile(
+				TEXT("#") + RunKey
+					+ TEXT("\n/Game/Meshes/Prop/SM_Prop_Desk\n/Game/Meshes/Prop/SM_Prop_Lamp\n/Game/Meshes/Prop/SM_Pr"),
+				*JournalPath
+			);
+			TSet<FString> Completed = AAutoMesh::LoadJournal(JournalFilename, RunKey);
+			TestEqual(TEXT("Testing Num"), Completed.Num(), 2);
+			TestTrue(TEXT("Testing Desk"), Completed.Contains(TEXT("/Game/Meshes/Prop/SM_Prop_Desk")));
+			TestTrue(TEXT("Testing Lamp"), Completed.Contains(TEXT("/Game/Meshes/Prop/SM_Prop_Lamp")));
+		});
+
+		It("should keep record appended after rewriting truncated journal", [this]()
+		{
+			FFileHelper::SaveStringToFile(
+				TEXT("#") + RunKey + TEXT("\n/Game/Meshes/Prop/SM_Prop_Desk\n/Game/Meshes/Prop/SM_Pr"),
+				*JournalPath
+			);
+			TSet<FString> Completed = AAutoMesh::LoadJournal(JournalFilename, RunKey);
+			TestTrue(TEXT("Testing WriteJournal"), AAutoMesh::WriteJournal(JournalFilename, RunKey, Completed));
+			FFileHelper::SaveStringToFile(
+				TEXT("/Game/Meshes/Prop/SM_Prop_Lamp\n"),
+				*JournalPath,
+				FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+				&IFileManager::Get(),
+				FILEWRITE_Append
+			);
+			Completed = AAutoMesh::LoadJournal(JournalFilename, RunKey);
+			TestEqual(TEXT("Testing Num"), Completed.Num(), 2);
+			TestTrue(TEXT("Testing Desk"), Completed.Contains(TEXT("/Game/Meshes/Prop/SM_Prop_Desk")));
+			TestTrue(TEXT("Testing Lamp"), Completed.Contains(TEXT("/Game/Meshes/Prop/SM_Prop_Lamp")));
+		});
+
+		It("should return empty set from journal of different run key", [this]()
+		{
+			TestTrue(
+				TEXT("Testing WriteJournal"),
+				AAutoMesh::WriteJournal(JournalFilename, RunKey, {TEXT("/Game/Meshes/Prop/SM_Prop_Desk")})
+			);
+			const FString OtherRunKey = AAutoMesh::GetJournalRunKey({TEXT("/Game/Meshes/Prop/SM_Prop_Desk")});
+			TestEqual(TEXT("Testing Same Key"), AAutoMesh::LoadJournal(JournalFilename, RunKey).Num(), 1);
+			TestEqual(TEXT("Testing Other Key"), AAutoMesh::LoadJournal(JournalFilename, OtherRunKey).Num(), 0);
+		});
+
+		It("should replace existing journal without leaving temporary file", [this]()
+		{
+			AAutoMesh::WriteJournal(JournalFilename, RunKey, {TEXT("/Game/Meshes/Prop/SM_Prop_Desk")});
+			TestTrue(
+				TEXT("Testing WriteJournal"),
+				AAutoMesh::WriteJournal(JournalFilename, RunKey, {TEXT("/Game/Meshes/Prop/SM_Prop_Lamp")})
+			);
+			TSet<FString> Completed = AAutoMesh::LoadJournal(JournalFilename, RunKey);
+			TestEqual(TEXT("Testing Num"), Completed.Num(), 1);
+			TestTrue(TEXT("Testing Lamp"), Completed.Contains(TEXT("/Game/Meshes/Prop/SM_Prop_Lamp")));
+			TestFalse(TEXT("Testing Temporary"), IFileManager::Get().FileExists(*(JournalPath + TEXT(".tmp"))));
+		});
+
+		It("should return same run key regardless of input order", [this]()
+		{
+			TestEqual(
+				TEXT("Testing Order"),
+				AAutoMesh::GetJournalRunKey({
+					TEXT("/Game/Meshes/Prop/SM_Prop_Chair"),
+					TEXT("/Game/Meshes/Prop/SM_Prop_Desk"),
+					TEXT("/Game/Meshes/Prop/SM_Prop_Lamp")
+				}),
+				RunKey
+			);
+		});
+
+		It("should return empty set from missing journal", [this]()
+		{
+			TSet<FString> Completed = AAutoMesh::LoadJournal(JournalFilename, RunKey);
+			TestEqual(TEXT("Testing Num"), Completed.Num(), 0);
+		});
+
+		AfterEach([this]()
+		{
+			IFileManager::Get().Delete(*JournalPath, false, false, true);
+		});
+	});
+}
+
+BEGIN_DEFINE_SPEC(
+	SpecGetStaticMeshPackageName,
+	"Texturematica.AutoMeshDependencyIndex.SpecGetStaticMeshPackageName",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+END_DEFINE_SPEC(SpecGetStaticMeshPackageName)
+
+void SpecGetStaticMeshPackageName::Define()
+{
+	Describe("Execute()", [this]()
+	{
+		It("should return static mesh package name from texture package name", [this]()
+		{
+			TestEqual(
+				TEXT("Testing Texture"),
+				FAutoMeshDependencyIndex::GetStaticMeshPackageName(TEXT("/Game/Textures/Prop/T_Prop_Desk_N")),
+				FName(TEXT("/Game/Meshes/Prop/SM_Prop_Desk"))
+			);
+		});
+
+		It("should return static mesh package name from material instance package name", [this]()
+		{
+			TestEqual(
+				TEXT("Testing Material Instance"),
+				FAutoMeshDependencyIndex::GetStaticMeshPackageName(TEXT("/Game/Materials/Structure/MI_Structure_Wall")),
+				FName(TEXT("/Game/Meshes/Structure/SM_Structure_Wall"))
+			);
+		});
+
+		It("should return NAME_None from other package names", [this]()
+		{
+			TestTrue(
+				TEXT("Testing Master Material"),
+				FAutoMeshDependencyIndex::GetStaticMeshPackageName(TEXT("/Game/Materials/M_Prop")).IsNone()
+			);
+			TestTrue(
+				TEXT("Testing Bad Texture Suffix"),
+				FAutoMeshDependencyIndex::GetStaticMeshPackageName(TEXT("/Game/Textures/Prop/T_Prop_Desk_R")).IsNone()
+			);
+		});
+	});
+}
+
+namespace AutoMeshTest
+{
+	// Dependency index over an in-memory package graph, the asset registry only records dependencies of saved packages
+	class FTestDependencyIndex : public FAutoMeshDependencyIndex
+	{
+	public:
+		void AddPackage(const TCHAR* PackageName)
+		{
+			Packages.Add(FName(PackageName));
+		}
+
+		void AddReference(const TCHAR* Referencer, const TCHAR* Dependency)
+		{
+			Referencers.FindOrAdd(FName(Dependency)).AddUnique(FName(Referencer));
+			Dependencies.FindOrAdd(FName(Referencer)).AddUnique(FName(Dependency));
+		}
+
+	protected:
+		virtual void GetReferencers(const FName PackageName, TArray<FName>& OutReferencers) const override
+		{
+			if (const TArray<FName>* Found = Referencers.Find(PackageName))
+			{
+				OutReferencers.Append(*Found);
+			}
+		}
+
+		virtual void GetDependencies(const FName PackageName, TArray<FName>& OutDependencies) const override
+		{
+			if (const TArray<FName>* Found = Dependencies.Find(PackageName))
+			{
+				OutDependencies.Append(*Found);
+			}
+		}
+
+		virtual bool DoesPackageExist(const FName PackageName) const override
+		{
+			return Packages.Contains(PackageName);
+		}
+
+	private:
+		TSet<FName> Packages;
+		TMap<FName, TArray<FName>> Referencers;
+		TMap<FName, TArray<FName>> Dependencies;
+	};
+}
+
+BEGIN_DEFINE_SPEC(
+	SpecGetImpactedPackages,
+	"Texturematica.AutoMeshDependencyIndex.SpecGetImpactedPackages",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+	TUniquePtr<AutoMeshTest::FTestDependencyIndex> Index;
+	TSet<FName> StaticMeshes;
+	TSet<FName> MaterialInstances;
+
+	void GetImpacted(const TCHAR* ChangedPackageName)
+	{
+		StaticMeshes.Reset();
+		MaterialInstances.Reset();
+		Index->GetImpactedPackages({FName(ChangedPackageName)}, StaticMeshes, MaterialInstances);
+	}
+END_DEFINE_SPEC(SpecGetImpactedPackages)
+
+void SpecGetImpactedPackages::Define()
+{
+	Describe("Execute()", [this]()
+	{
+		BeforeEach([this]()
+		{
+			Index = MakeUnique<AutoMeshTest::FTestDependencyIndex>();
+			for (const TCHAR* PackageName : {
+				TEXT("/Game/Textures/Prop/T_Prop_Desk_D"),
+				TEXT("/Game/Textures/Prop/T_Prop_Chair_D"),
+				TEXT("/Game/Materials/M_Prop"),
+				TEXT("/Game/Materials/Prop/MI_Prop_Desk"),
+				TEXT("/Game/Materials/Prop/MI_Prop_Lamp"),
+				TEXT("/Game/Meshes/Prop/SM_Prop_Desk"),
+				TEXT("/Game/Meshes/Prop/SM_Prop_Lamp"),
+				TEXT("/Game/Meshes/Prop/SM_Prop_Chair")})
+			{
+				Index->AddPackage(PackageName);
+			}
+			Index->AddReference(TEXT("/Game/Materials/Prop/MI_Prop_Desk"), TEXT("/Game/Textures/Prop/T_Prop_Desk_D"));
+			Index->AddReference(TEXT("/Game/Materials/Prop/MI_Prop_Desk"), TEXT("/Game/Materials/M_Prop"));
+			Index->AddReference(TEXT("/Game/Materials/Prop/MI_Prop_Lamp"), TEXT("/Game/Materials/M_Prop"));
+			Index->AddReference(TEXT("/Game/Meshes/Prop/SM_Prop_Desk"), TEXT("/Game/Materials/Prop/MI_Prop_Desk"));
+			Index->AddReference(TEXT("/Game/Meshes/Prop/SM_Prop_Lamp"), TEXT("/Game/Materials/Prop/MI_Prop_Lamp"));
+		});
+
+		It("should walk texture referencers to material instance and static mesh", [this]()
+		{
+			GetImpacted(TEXT("/Game/Textures/Prop/T_Prop_Desk_D"));
+			TestEqual(TEXT("Testing Num Static Meshes"), StaticMeshes.Num(), 1);
+			TestTrue(TEXT("Testing Desk"), StaticMeshes.Contains(FName(TEXT("/Game/Meshes/Prop/SM_Prop_Desk"))));
+			TestEqual(TEXT("Testing Num Material Instances"), MaterialInstances.Num(), 1);
+			TestTrue(
+				TEXT("Testing MI Desk"),
+				MaterialInstances.Contains(FName(TEXT("/Game/Materials/Prop/MI_Prop_Desk")))
+			);
+		});
+
+		It("should walk master material referencers to every material instance and static mesh", [this]()
+		{
+			GetImpacted(TEXT("/Game/Materials/M_Prop"));
+			TestEqual(TEXT("Testing Num Static Meshes"), StaticMeshes.Num(), 2);
+			TestTrue(TEXT("Testing Desk"), StaticMeshes.Contains(FName(TEXT("/Game/Meshes/Prop/SM_Prop_Desk"))));
+			TestTrue(TEXT("Testing Lamp"), StaticMeshes.Contains(FName(TEXT("/Game/Meshes/Prop/SM_Prop_Lamp"))));
+			TestEqual(TEXT("Testing Num Material Instances"), MaterialInstances.Num(), 2);
+		});
+
+		It("should map unreferenced texture to static mesh by name", [this]()
+		{
+			GetImpacted(TEXT("/Game/Textures/Prop/T_Prop_Chair_D"));
+			TestEqual(TEXT("Testing Num Static Meshes"), StaticMeshes.Num(), 1);
+			TestTrue(TEXT("Testing Chair"), StaticMeshes.Contains(FName(TEXT("/Game/Meshes/Prop/SM_Prop_Chair"))));
+			TestEqual(TEXT("Testing Num Material Instances"), MaterialInstances.Num(), 0);
+		});
+
+		It("should only rebuild entries affected by an added material instance", [this]()
+		{
+			GetImpacted(TEXT("/Game/Textures/Prop/T_Prop_Desk_D"));
+			GetImpacted(TEXT("/Game/Textures/Prop/T_Prop_Chair_D"));
+			GetImpacted(TEXT("/Game/Materials/M_Prop"));
+			TestTrue(TEXT("Testing Cached Desk"), Index->IsCached(TEXT("/Game/Textures/Prop/T_Prop_Desk_D")));
+			TestTrue(TEXT("Testing Cached Chair"), Index->IsCached(TEXT("/Game/Textures/Prop/T_Prop_Chair_D")));
+			TestTrue(TEXT("Testing Cached M_Prop"), Index->IsCached(TEXT("/Game/Materials/M_Prop")));
+
+			Index->AddPackage(TEXT("/Game/Materials/Prop/MI_Prop_Chair"));
+			Index->AddReference(TEXT("/Game/Materials/Prop/MI_Prop_Chair"), TEXT("/Game/Textures/Prop/T_Prop_Chair_D"));
+			Index->AddReference(TEXT("/Game/Materials/Prop/MI_Prop_Chair"), TEXT("/Game/Materials/M_Prop"));
+			Index->AddReference(TEXT("/Game/Meshes/Prop/SM_Prop_Chair"), TEXT("/Game/Materials/Prop/MI_Prop_Chair"));
+			Index->NotifyPackageChanged(TEXT("/Game/Materials/Prop/MI_Prop_Chair"));
+			
+			TestTrue(TEXT("Testing Kept Desk"), Index->IsCached(TEXT("/Game/Textures/Prop/T_Prop_Desk_D")));
+			TestFalse(TEXT("Testing Invalidated Chair"), Index->IsCached(TEXT("/Game/Textures/Prop/T_Prop_Chair_D")));
+			TestFalse(TEXT("Testing Invalidated M_Prop"), Index->IsCached(TEXT("/Game/Materials/M_Prop")));
+
+			GetImpacted(TEXT("/Game/Textures/Prop/T_Prop_Chair_D"));
+			TestEqual(TEXT("Testing Num Chair Material Instances"), MaterialInstances.Num(), 1);
+			GetImpacted(TEXT("/Game/Materials/M_Prop"));
+			TestEqual(TEXT("Testing Num M_Prop Static Meshes"), StaticMeshes.Num(), 3);
+			TestEqual(TEXT("Testing Num M_Prop Material Instances"), MaterialInstances.Num(), 3);
+		});
+
+		AfterEach([this]()
+		{
+			Index.Reset();
+		});
+	});
+}
+
+BEGIN_DEFINE_SPEC(
+	SpecProfilerScope,
+	"Texturematica.AutoMeshProfiler.SpecProfilerScope",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+	FName MeshName;
+	FString ReportFilename;
+END_DEFINE_SPEC(SpecProfilerScope)
+
+void SpecProfilerScope::Define()
+{
+	Describe("Execute()", [this]()
+	{
+		BeforeEach([this]()
+		{
+			MeshName = FName(TEXT("/Game/Meshes/Prop/SM_Prop_Desk"));
+			ReportFilename = TEXT("SpecProfilerScope.csv");
+			FAutoMeshProfiler::Get().BeginSession();
+		});
+
+		It("should count UObjects of nested scopes exclusively", [this]()
+		{
+			{
+				FAutoMeshProfiler::FScope Outer(TEXT("MaterialInstance"), MeshName);
+				NewObject<UObject>(GetTransientPackage());
+				NewObject<UObject>(GetTransientPackage());
+				{
+					FAutoMeshProfiler::FScope Inner(TEXT("Textures"), MeshName);
+					NewObject<UObject>(GetTransientPackage());
+					NewObject<UObject>(GetTransientPackage());
+					NewObject<UObject>(GetTransientPackage());
+				}
+			}
+			{
+				FAutoMeshProfiler::FScope Inner(TEXT("Textures"), MeshName);
+				NewObject<UObject>(GetTransientPackage());
+			}
+			
+			const FAutoMeshProfiler::FStageStats Outer = FAutoMeshProfiler::Get().GetStageStats(
+				TEXT("MaterialInstance"),
+				MeshName
+			);
+			const FAutoMeshProfiler::FStageStats Inner = FAutoMeshProfiler::Get().GetStageStats(
+				TEXT("Textures"),
+				MeshName
+			);
+			TestEqual(TEXT("Testing Outer Calls"), Outer.Calls, 1);
+			TestEqual(TEXT("Testing Outer UObjects"), Outer.UObjects, static_cast<uint64>(2));
+			TestEqual(TEXT("Testing Inner Calls"), Inner.Calls, 2);
+			TestEqual(TEXT("Testing Inner UObjects"), Inner.UObjects, static_cast<uint64>(4));
+		});
+
+		It("should count allocations of nested scopes exclusively", [this]()
+		{
+			FAutoMeshProfiler::CountAllocation(1024);
+			{
+				FAutoMeshProfiler::FScope Outer(TEXT("MaterialInstance"), MeshName);
+				FAutoMeshProfiler::CountAllocation(100);
+				{
+					FAutoMeshProfiler::FScope Inner(TEXT("Textures"), MeshName);
+					FAutoMeshProfiler::CountAllocation(10);
+					FAutoMeshProfiler::CountAllocation(10);
+					FAutoMeshProfiler::CountAllocation(0);
+				}
+				FAutoMeshProfiler::CountAllocation(100);
+			}
+			
+			const FAutoMeshProfiler::FStageStats Outer = FAutoMeshProfiler::Get().GetStageStats(
+				TEXT("MaterialInstance"),
+				MeshName
+			);
+			const FAutoMeshProfiler::FStageStats Inner = FAutoMeshProfiler::Get().GetStageStats(
+				TEXT("Textures"),
+				MeshName
+			);
+			TestEqual(TEXT("Testing Outer Bytes"), Outer.Bytes, static_cast<uint64>(200));
+			TestEqual(TEXT("Testing Outer Allocations"), Outer.Allocations, static_cast<uint64>(2));
+			TestEqual(TEXT("Testing Inner Bytes"), Inner.Bytes, static_cast<uint64>(20));
+			TestEqual(TEXT("Testing Inner Allocations"), Inner.Allocations, static_cast<uint64>(2));
+		});
+
+		It("should add allocations of worker scopes to the game thread scope", [this]()
+		{
+			{
+				FAutoMeshProfiler::FScope Outer(TEXT("Validate"), MeshName);
+				ParallelFor(16, [](const int32 /*Index*/)
+				{
+					AUTOMESH_PROFILE_WORKER_SCOPE(Validate);
+					FAutoMeshProfiler::CountAllocation(64);
+				});
+			}
+			
+			const FAutoMeshProfiler::FStageStats Stats = FAutoMeshProfiler::Get().GetStageStats(
+				TEXT("Validate"),
+				MeshName
+			);
+			TestEqual(TEXT("Testing Bytes"), Stats.Bytes, static_cast<uint64>(16 * 64));
+			TestEqual(TEXT("Testing Allocations"), Stats.Allocations, static_cast<uint64>(16));
+		});
+
+		It("should not record scopes outside a session", [this]()
+		{
+			FAutoMeshProfiler::Get().EndSession(ReportFilename);
+			FAutoMeshProfiler::Get().BeginSession();
+			FAutoMeshProfiler::Get().EndSession(ReportFilename);
+			{
+				FAutoMeshProfiler::FScope Outer(TEXT("Assign"), MeshName);
+				NewObject<UObject>(GetTransientPackage());
+			}
+			TestEqual(
+				TEXT("Testing Calls"),
+				FAutoMeshProfiler::Get().GetStageStats(TEXT("Assign"), MeshName).Calls,
+				0
+			);
+		});
+
+		AfterEach([this]()
+		{
+			if (FAutoMeshProfiler::Get().IsActive())
+			{
+				FAutoMeshProfiler::Get().EndSession(ReportFilename);
+			}
+			IFileManager::Get().Delete(
+				*FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AutoMesh"), ReportFilename),
+				false,
+				false,
+				true
+			);
+		});
+	});
+}
@@ -2,6 +2,10 @@
 
 #include "Texturematica.h"
 
+#include "AutoMesh.h"
+#include "AutoMeshDependencyIndex.h"
+#include "AutoMeshProfiler.h"
+
 #define LOCTEXT_NAMESPACE "FTexturematicaModule"
 
 void FTexturematicaModule::StartupModule()
@@ -13,6 +17,9 @@ void FTexturematicaModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FAutoMeshDependencyIndex::Shutdown();
+	FAutoMeshProfiler::Shutdown();
+	AAutoMesh::ResetFactoryPool();
 }
 
 #undef LOCTEXT_NAMESPACE
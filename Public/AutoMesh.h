@@ -9,6 +9,73 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogAutoMesh, Log, All);
 
+/**
+ * Per-channel statistics of a texture's source pixels in linear space.
+ */
+USTRUCT(BlueprintType)
+struct FAutoMeshTextureStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	FLinearColor Min = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	FLinearColor Max = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	FLinearColor Mean = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+	// Largest per-pixel difference between the R, G and B channels.
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	float MaxChannelDelta = 0.0f;
+};
+
+/**
+ * Validation result for a single texture bound to a material instance parameter.
+ */
+USTRUCT(BlueprintType)
+struct FAutoMeshTextureReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	FString PackageName;
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	FName Param;
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	int32 SizeX = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	int32 SizeY = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	FAutoMeshTextureStats Stats;
+
+	// Texture is a single color and could be replaced by a scalar/vector parameter.
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	bool bConstantColor = false;
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	bool bNonPowerOfTwo = false;
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	bool bOversized = false;
+
+	// Mask is sRGB, single channel, or has identical R/G/B (not AO/Roughness/Metallic packed).
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	bool bBadMaskPacking = false;
+
+	// Source mip could not be read, stats and flags are not valid.
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	bool bReadFailed = false;
+
+	UPROPERTY(BlueprintReadOnly, Category="AutoMesh")
+	bool bFixed = false;
+};
+
 /**
  * This class helps automate the pipeline detailed in the Epic Games course
  * "Build a Detective's Office Game Environment".
@@ -79,7 +146,8 @@ public:
 	static UMaterialInstanceConstant* CreateMaterialInstance(UMaterial* MasterMaterial, UStaticMesh* StaticMesh);
 
 	/**
-	 * Create asset from factory and object data. Generalised to create different kinds of objects.
+	 * Create asset from factory and object data, existing asset is loaded instead. Generalised to create different
+	 * kinds of objects.
 	 * @param Factory - Factory used to create new instance.
 	 * @param StaticClass - Class from which to create asset.
 	 * @param ObjectName - Object name of asset.
@@ -106,4 +174,151 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="AutoMesh")
 	static UStaticMesh* AssignMaterial(UMaterialInstanceConstant* MaterialInstance, UStaticMesh* StaticMesh);
+
+	/**
+	 * Get texture package name for a material parameter from static mesh path.
+	 * e.g.: /Game/Meshes/Prop/SM_Prop_MeshName, "Mask" -> /Game/Textures/Prop/T_Prop_MeshName_M
+	 * @param StaticMesh - Mesh object from which to derive texture path.
+	 * @param Param - "Diffuse", "Mask" or "Normal", first letter is used as texture suffix.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static FString GetTexturePackageName(UStaticMesh* StaticMesh, FName Param);
+
+	/**
+	 * Validate "Diffuse", "Mask", "Normal" textures of static mesh. Source mips are read and analysed in parallel.
+	 * Flags constant color, non-power-of-two, oversized textures, and incorrectly packed masks.
+	 * @param StaticMesh - Mesh object from which to derive paths for textures.
+	 * @param MaxTextureSize - Largest allowed texture dimension.
+	 * @param bAutoFix - Clamp oversized and constant color textures, fix mask compression settings.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static TArray<FAutoMeshTextureReport> ValidateTextures(UStaticMesh* StaticMesh, int32 MaxTextureSize = 4096,
+		bool bAutoFix = false);
+
+	/**
+	 * Write texture validation reports as CSV to Saved/AutoMesh/.
+	 * @param Reports - Reports returned by ValidateTextures.
+	 * @param ReportFilename - Filename of CSV report.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static bool WriteTextureReport(const TArray<FAutoMeshTextureReport>& Reports, FString ReportFilename);
+
+	/**
+	 * Compute per-channel min/max/mean of linear pixels. Chunks are reduced in parallel with SIMD registers.
+	 * @param Pixels - Linear RGBA pixels.
+	 */
+	static FAutoMeshTextureStats ComputeTextureStats(TArrayView64<const FLinearColor> Pixels);
+
+	/**
+	 * Get texture package name for a source image file, empty if file is not named T_[Prop|Structure]_MeshName_[D|M|N].
+	 * e.g.: /Drop/T_Prop_MeshName_D.png -> /Game/Textures/Prop/T_Prop_MeshName_D
+	 * @param SourceFilename - Filename of PNG, TGA or EXR image.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static FString GetImportPackageName(FString SourceFilename);
+
+	/**
+	 * Import PNG, TGA and EXR images from source directory as T_*_[D|M|N] textures under /Game/Textures/.
+	 * Images are decoded in parallel in batches bounded by decoded size, only texture creation runs on the
+	 * game thread. Existing textures are reimported when the source file hash differs from the one stored
+	 * at import, and skipped when it matches. Duplicate sources mapping to the same package are skipped.
+	 * @param SourceDir - Directory searched recursively for source images.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static TArray<UTexture2D*> ImportTextures(FString SourceDir);
+
+	/**
+	 * Save asset to its package file.
+	 * @param Asset - Asset to save.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static bool SaveAsset(UObject* Asset);
+
+	/**
+	 * Get key identifying a pipeline run by its input static meshes, independent of their order.
+	 * @param StaticMeshPackageNames - Package names of static meshes in run.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static FString GetJournalRunKey(TArray<FString> StaticMeshPackageNames);
+
+	/**
+	 * Load static mesh package names recorded as completed in pipeline journal under Saved/AutoMesh/.
+	 * Empty if the journal was written for a different run key.
+	 * @param JournalFilename - Filename of journal.
+	 * @param RunKey - Key of current run from GetJournalRunKey.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static TSet<FString> LoadJournal(FString JournalFilename, FString RunKey);
+
+	/**
+	 * Write pipeline journal with run key header and completed records, replacing any existing journal.
+	 * Written to a temporary file first, so a crash never leaves a partially rewritten journal.
+	 * @param JournalFilename - Filename of journal.
+	 * @param RunKey - Key of current run from GetJournalRunKey.
+	 * @param Completed - Static mesh package names already completed.
+	 */
+	static bool WriteJournal(const FString& JournalFilename, const FString& RunKey, const TSet<FString>& Completed);
+
+	/**
+	 * Run material pipeline on static meshes, appending each completed mesh to a journal under Saved/AutoMesh/.
+	 * A cancelled or crashed run of the same input set resumes from the journal, existing M_* and MI_* assets are
+	 * reused.
+	 * @param StaticMeshObjects - AStaticMeshActor, UStaticMeshComponent, or UStaticMesh objects.
+	 * @param JournalFilename - Filename of journal.
+	 * @param bFresh - Ignore journal and process every mesh. Inputs edited since the cancelled run are not
+	 *	detected, use this when they changed.
+	 * @param bValidate - Validate textures before creating material instances, report is written to
+	 *	Saved/AutoMesh/[JournalName]_TextureReport.csv.
+	 * @param MaxTextureSize - Largest allowed texture dimension, see ValidateTextures.
+	 * @param bAutoFix - Fix flagged textures before they are bound, see ValidateTextures.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static TArray<UStaticMesh*> ProcessStaticMeshes(const TArray<UObject*>& StaticMeshObjects,
+		FString JournalFilename = TEXT("AutoMesh.journal"), bool bFresh = false, bool bValidate = true,
+		int32 MaxTextureSize = 4096, bool bAutoFix = false);
+
+	/**
+	 * Get package names of static meshes affected by changed texture or material packages.
+	 * Uses asset registry referencers and T_/MI_/SM_ naming, see FAutoMeshDependencyIndex.
+	 * @param ChangedPackageNames - Long package names of changed textures or materials.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static TArray<FString> GetImpactedStaticMeshes(const TArray<FString>& ChangedPackageNames);
+
+	/**
+	 * Run material pipeline only on static meshes affected by changed texture or material packages.
+	 * @param ChangedPackageNames - Long package names of changed textures or materials.
+	 * @param JournalFilename - Filename of journal.
+	 * @param bFresh - Ignore journal of a cancelled run of the same impacted set and process every mesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static TArray<UStaticMesh*> ProcessChangedPackages(const TArray<FString>& ChangedPackageNames,
+		FString JournalFilename = TEXT("AutoMeshChanged.journal"), bool bFresh = false);
+
+	/**
+	 * Import textures from source directory and run material pipeline on the static meshes they affect.
+	 * @param SourceDir - Directory searched recursively for source images.
+	 * @param JournalFilename - Filename of journal.
+	 * @param bFresh - Ignore journal of a cancelled run of the same impacted set and process every mesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static TArray<UStaticMesh*> ImportAndProcessTextures(FString SourceDir,
+		FString JournalFilename = TEXT("AutoMeshImport.journal"), bool bFresh = false);
+
+	/**
+	 * Start profiling bytes allocated, allocation counts and UObjects created per pipeline stage per mesh.
+	 * Engine internal allocations are recorded by -llm and Memory Insights, see FAutoMeshProfiler.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static void BeginProfiling();
+
+	/**
+	 * End profiling and write CSV report to Saved/AutoMesh/.
+	 * @param ReportFilename - Filename of CSV report.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AutoMesh")
+	static bool EndProfiling(FString ReportFilename);
+
+	// Release pooled asset factories, called on module shutdown.
+	static void ResetFactoryPool();
 };
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+class IAssetRegistry;
+
+/**
+ * Index of which static meshes and material instances are affected by changes to texture or material packages.
+ *
+ * Combines the asset registry referencer graph with the AutoMesh naming layout, so a texture which is not yet
+ * bound to a material instance still maps to its static mesh. i.e:
+ *
+ * /Game/Textures/Prop/T_Prop_MeshName_D -> /Game/Meshes/Prop/SM_Prop_MeshName
+ * /Game/Materials/Prop/MI_Prop_MeshName -> /Game/Meshes/Prop/SM_Prop_MeshName
+ * /Game/Materials/M_Prop -> MI_* referencers -> SM_* referencers
+ *
+ * Results are cached per changed package and only the entries whose traversal touched an added, removed,
+ * renamed or updated package are invalidated.
+ */
+class TEXTUREMATICA_API FAutoMeshDependencyIndex
+{
+public:
+	FAutoMeshDependencyIndex();
+	virtual ~FAutoMeshDependencyIndex();
+
+	// Get index, created on first use.
+	static FAutoMeshDependencyIndex& Get();
+
+	// Destroy index, called on module shutdown.
+	static void Shutdown();
+
+	/**
+	 * Get static mesh and material instance packages affected by changed packages.
+	 * @param ChangedPackageNames - Long package names of changed textures or materials.
+	 * @param OutStaticMeshes - Package names of static meshes to reprocess.
+	 * @param OutMaterialInstances - Package names of material instances to reprocess.
+	 */
+	void GetImpactedPackages(const TArray<FName>& ChangedPackageNames, TSet<FName>& OutStaticMeshes,
+		TSet<FName>& OutMaterialInstances);
+
+	/**
+	 * Get static mesh package name derived from T_ or MI_ package name, NAME_None for other packages.
+	 * @param PackageName - Long package name of texture or material instance.
+	 */
+	static FName GetStaticMeshPackageName(FName PackageName);
+
+	/**
+	 * Invalidate cached entries which walked through an added, removed or updated package or its dependencies.
+	 * @param PackageName - Long package name of changed package.
+	 */
+	void NotifyPackageChanged(FName PackageName);
+
+	/**
+	 * Whether impact of a changed package is cached.
+	 * @param PackageName - Long package name passed to GetImpactedPackages.
+	 */
+	bool IsCached(FName PackageName) const;
+
+protected:
+	// Asset registry queries, overridden by tests to supply a package graph
+	virtual void GetReferencers(FName PackageName, TArray<FName>& OutReferencers) const;
+	virtual void GetDependencies(FName PackageName, TArray<FName>& OutDependencies) const;
+	virtual bool DoesPackageExist(FName PackageName) const;
+
+private:
+	struct FImpact
+	{
+		TSet<FName> StaticMeshes;
+		TSet<FName> MaterialInstances;
+		// Every package read while building this entry, including derived names which may not exist yet
+		TSet<FName> Visited;
+	};
+
+	const FImpact& FindOrBuildImpact(FName PackageName);
+	void Invalidate(FName PackageName);
+	void OnAssetChanged(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	IAssetRegistry* AssetRegistry = nullptr;
+	TMap<FName, FImpact> Impacts;
+	TMap<FName, TSet<FName>> VisitedBy;
+	FDelegateHandle AddedHandle;
+	FDelegateHandle RemovedHandle;
+	FDelegateHandle RenamedHandle;
+	FDelegateHandle UpdatedHandle;
+};
@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/UObjectArray.h"
+
+#include <atomic>
+
+LLM_DECLARE_TAG_API(AutoMesh_Import, TEXTUREMATICA_API);
+LLM_DECLARE_TAG_API(AutoMesh_Validate, TEXTUREMATICA_API);
+LLM_DECLARE_TAG_API(AutoMesh_MasterMaterial, TEXTUREMATICA_API);
+LLM_DECLARE_TAG_API(AutoMesh_MaterialInstance, TEXTUREMATICA_API);
+LLM_DECLARE_TAG_API(AutoMesh_Textures, TEXTUREMATICA_API);
+LLM_DECLARE_TAG_API(AutoMesh_Assign, TEXTUREMATICA_API);
+LLM_DECLARE_TAG_API(AutoMesh_Save, TEXTUREMATICA_API);
+
+/**
+ * Tag a pipeline stage for LLM (-llm), Memory Insights (-trace=memory,cpu) and the AutoMesh profiling session.
+ * LLM tags are emitted as memory trace tags, so the same stage names show up in Memory Insights.
+ * @param Stage - One of Import, Validate, MasterMaterial, MaterialInstance, Textures, Assign, Save.
+ * @param MeshName - FName of static mesh package, NAME_None for stages not bound to a mesh.
+ */
+#define AUTOMESH_PROFILE_SCOPE(Stage, MeshName) \
+	LLM_SCOPE_BYTAG(AutoMesh_##Stage); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(AutoMesh_##Stage); \
+	FAutoMeshProfiler::FScope PREPROCESSOR_JOIN(AutoMeshProfileScope, __LINE__)(TEXT(#Stage), MeshName)
+
+/**
+ * Tag the worker thread body of a stage, e.g. a ParallelFor lambda. Allocations counted on the worker are added
+ * to the game thread scope running the stage.
+ * @param Stage - Stage of the enclosing AUTOMESH_PROFILE_SCOPE.
+ */
+#define AUTOMESH_PROFILE_WORKER_SCOPE(Stage) \
+	LLM_SCOPE_BYTAG(AutoMesh_##Stage); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(AutoMesh_##Stage); \
+	FAutoMeshProfiler::FWorkerScope PREPROCESSOR_JOIN(AutoMeshProfileWorkerScope, __LINE__)
+
+/**
+ * Per stage, per mesh memory profiling of the AutoMesh pipeline.
+ *
+ * While a session is active, bytes and allocations are counted by CountAllocations() calls on the buffers the
+ * pipeline fills (asset name strings, texture pixels, compressed files), on the game thread inside a scope and
+ * on workers inside AUTOMESH_PROFILE_WORKER_SCOPE. Each non-empty container counts as one allocation of its
+ * allocated size, so temporaries of chained string calls are not included. Allocations made inside the engine
+ * (package loading, UObject creation, texture builds) are not counted, record those with -llm or
+ * -trace=memory and read the AutoMesh_* tags in Memory Insights. UObjects created are counted by a
+ * GUObjectArray listener. All counts are exclusive, a scope does not include the nested scopes it calls.
+ */
+class TEXTUREMATICA_API FAutoMeshProfiler : public FUObjectArray::FUObjectCreateListener
+{
+public:
+	struct FStageStats
+	{
+		int32 Calls = 0;
+		// Bytes allocated, not net of frees
+		uint64 Bytes = 0;
+		uint64 Allocations = 0;
+		uint64 UObjects = 0;
+	};
+
+	/**
+	 * Accumulates counters of a stage into the active session, does nothing without one.
+	 */
+	class TEXTUREMATICA_API FScope
+	{
+	public:
+		FScope(const TCHAR* InStage, FName InMeshName);
+		~FScope();
+
+	private:
+		const TCHAR* Stage;
+		FName MeshName;
+		FScope* Parent = nullptr;
+		FStageStats Start;
+		FStageStats Children;
+		bool bWasCounting = false;
+		bool bActive = false;
+	};
+
+	/**
+	 * Enables allocation counting on a worker thread, does nothing on the game thread or without a session.
+	 */
+	class TEXTUREMATICA_API FWorkerScope
+	{
+	public:
+		FWorkerScope();
+		~FWorkerScope();
+
+	private:
+		uint64 StartBytes = 0;
+		uint64 StartAllocations = 0;
+		bool bWasCounting = false;
+		bool bActive = false;
+	};
+
+	virtual ~FAutoMeshProfiler() override;
+
+	// Get profiler, created on first use.
+	static FAutoMeshProfiler& Get();
+
+	// Destroy profiler, called on module shutdown.
+	static void Shutdown();
+
+	// Start a session, clearing previous results.
+	void BeginSession();
+
+	/**
+	 * End session and write CSV report of stats per stage per mesh to Saved/AutoMesh/.
+	 * @param ReportFilename - Filename of CSV report.
+	 */
+	bool EndSession(const FString& ReportFilename);
+
+	bool IsActive() const { return bActive; }
+
+	/**
+	 * Get stats of a stage for a mesh from the current or last session, zero if not recorded.
+	 * @param Stage - Stage name as passed to AUTOMESH_PROFILE_SCOPE.
+	 * @param MeshName - FName of static mesh package.
+	 */
+	FStageStats GetStageStats(const FString& Stage, FName MeshName) const;
+
+	/**
+	 * Count an allocation of the calling thread, ignored outside a scope.
+	 * @param Bytes - Allocated size, not counted when 0.
+	 */
+	static void CountAllocation(int64 Bytes);
+
+	// Count each non-empty container as one allocation of its GetAllocatedSize().
+	template <typename... ContainerTypes>
+	static void CountAllocations(const ContainerTypes&... Containers)
+	{
+		(CountAllocation(Containers.GetAllocatedSize()), ...);
+	}
+
+	// FUObjectCreateListener
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+
+private:
+	FStageStats GetCounters() const;
+
+	bool bActive = false;
+	FScope* CurrentScope = nullptr;
+	std::atomic<uint64> UObjectsCreated{0};
+	// Totals of finished worker scopes, read by game thread scopes running the workers
+	std::atomic<uint64> WorkerBytes{0};
+	std::atomic<uint64> WorkerAllocations{0};
+	TMap<FString, TMap<FName, FStageStats>> Stages;
+};
@@ -36,6 +36,8 @@ public class Texturematica : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"ImageCore",
+				"ImageWrapper",
 				"Slate",
 				"SlateCore",
 				"UnrealEd"